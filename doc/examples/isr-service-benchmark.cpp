@@ -0,0 +1,103 @@
+#include <iostream>
+#include <isr/isr-service.h>
+#include <isr/direct-isr-service.h>
+#include <profiling/posix-cycle-counter.h>
+
+namespace djetk {
+
+// Driver that can be bound either way. The handler is typical of a small
+// peripheral: it reads a data register and counts events.
+class CountingDriver : private IIsrHandler
+{
+  public:
+    CountingDriver()
+        : count_(0),
+        data_register_(0)
+    {
+    }
+
+    void Register(IIsrService &isr_service)
+    {
+        isr_service.RegisterHandler(*this);
+    }
+
+    uint32_t GetCount() const
+    {
+        return count_;
+    }
+
+    virtual void HandleIsr(bool &task_woken) override
+    {
+        count_ += data_register_ + 1;
+        task_woken = false;
+    }
+
+  private:
+    uint32_t count_;
+    volatile uint32_t data_register_;
+};
+
+// Separate driver classes so that each binding gets its own service
+class RuntimeBoundDevice : public CountingDriver {};
+class CompileTimeBoundDevice : public CountingDriver {};
+
+RuntimeBoundDevice runtime_device;
+CompileTimeBoundDevice compile_time_device;
+
+// The IRQ vectors. Late binding goes through the registered handler pointer,
+// compile time binding calls the driver directly.
+extern "C" void RuntimeBoundIrqVector()
+{
+    bool task_woken;
+    IsrService<RuntimeBoundDevice>::ISR(task_woken);
+}
+
+extern "C" void CompileTimeBoundIrqVector()
+{
+    bool task_woken;
+    DirectIsrService<CompileTimeBoundDevice, compile_time_device>::ISR(task_woken);
+}
+
+}    // namespace djetk
+
+namespace {
+
+// Small enough for the nanosecond count not to wrap around at 32 bits
+constexpr uint32_t kIterations = 10000000;
+
+// Time a vector in nanoseconds per call. The call through the pointer keeps
+// the compiler from optimising the loop away.
+double Measure(void (* volatile vector)())
+{
+    djetk::PosixCycleCounter cycle_counter;
+    auto start = cycle_counter.GetCycles();
+    for (uint32_t i = 0; i < kIterations; i++) {
+        vector();
+    }
+
+    return static_cast<double>(cycle_counter.GetCycles() - start) / kIterations;
+}
+
+}    // namespace
+
+int main()
+{
+    using namespace djetk;
+
+    IsrService<RuntimeBoundDevice> isr_service;
+    runtime_device.Register(isr_service);
+
+    // Warm up the caches before measuring
+    Measure(RuntimeBoundIrqVector);
+    Measure(CompileTimeBoundIrqVector);
+
+    auto runtime_ns = Measure(RuntimeBoundIrqVector);
+    auto compile_time_ns = Measure(CompileTimeBoundIrqVector);
+
+    std::cout << "IsrService:       " << runtime_ns << " ns per interrupt" << std::endl;
+    std::cout << "DirectIsrService: " << compile_time_ns << " ns per interrupt" << std::endl;
+    std::cout << "Saved:            " << (runtime_ns - compile_time_ns)
+        << " ns per interrupt" << std::endl;
+
+    return (runtime_device.GetCount() == compile_time_device.GetCount()) ? 0 : 1;
+}
@@ -49,16 +49,17 @@ class Device2 : public SomeDriverBase {
 };
 
 // These are the interrupt handler vectors for the two peripherals of the same
-// device class
+// device class. On FreeRTOS, FreeRTOSIsrVector<IsrService<Device1>> also
+// switches to a woken task on return.
 extern "C" void Device1IrqVector()
 {
-    bool task_woken;
+    bool task_woken = false;
     IsrService<Device1>::ISR(task_woken);
 }
 
 extern "C" void Device2IrqVector()
 {
-    bool task_woken;
+    bool task_woken = false;
     IsrService<Device2>::ISR(task_woken);
 }
 
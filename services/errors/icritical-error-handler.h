@@ -40,6 +40,21 @@ class ICriticalErrorHandler {
      */
     static constexpr uint32_t isr_handler_error             = 3;
 
+    /**
+     * \brief An ISR handler or tick client overran its execution time budget
+     */
+    static constexpr uint32_t isr_budget_error              = 4;
+
+    /**
+     * \brief Error generated by the host operating system (native builds)
+     */
+    static constexpr uint32_t os_error                      = 5;
+
+    /**
+     * \brief An object was destroyed while a queued message still refers to it
+     */
+    static constexpr uint32_t lifetime_error                = 6;
+
     /**
      * \brief Application defined error code partition
      */
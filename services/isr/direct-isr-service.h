@@ -0,0 +1,67 @@
+/**
+    \file
+    \brief ISR Service bound to its handler at compile time
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DIRECT_ISR_SERVICE_H
+#define DIRECT_ISR_SERVICE_H
+
+namespace djetk {
+
+/**
+ * \brief ISR Service bound to its handler at compile time
+ * \param Driver    Class of the driver that handles the interrupt
+ * \param driver    The driver instance. It must have static storage duration
+ *                  (e.g. a global object).
+ *
+ * \ref IsrService looks up a registered \ref IIsrHandler and makes a virtual
+ * call on every interrupt. Here the driver is a template argument instead,
+ * so the IRQ vector calls Driver::HandleIsr directly on a known object and
+ * the handler can be inlined into the vector.
+ *
+ * Driver::HandleIsr(bool &task_woken) must be accessible to this class
+ * (public, or make DirectIsrService a friend). It needn't be virtual; if it
+ * is, the call is still resolved at compile time since the type of the
+ * driver object is known.
+ *
+ * Use \ref IsrService for drivers that are constructed at run time or that
+ * need to register late.
+ *
+ * \include isr-service-benchmark.cpp
+ */
+template <class Driver, Driver &driver>
+class DirectIsrService {
+  public:
+    /**
+     * \brief Device Driver ISR handler
+     * \param[out]  task_woken  Rescheduling required due to woken up task
+     *
+     * This method is to be invoked by the IRQ vector
+     */
+    static inline void ISR(bool &task_woken)
+    {
+        driver.HandleIsr(task_woken);
+    }
+};
+
+}    // namespace djetk
+
+#endif    // DIRECT_ISR_SERVICE_H
@@ -0,0 +1,61 @@
+/**
+    \file
+    \brief FreeRTOS interrupt vector entry point
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_ISR_VECTOR_H
+#define FREERTOS_ISR_VECTOR_H
+
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <os/freertos-isr-context.h>
+
+namespace djetk {
+
+/**
+ * \brief Interrupt vector for an ISR service on FreeRTOS
+ * \param Service   ISR service with a static ISR(bool &task_woken) method
+ *                  (e.g. IsrService<Driver>)
+ *
+ * Invokes the ISR and switches to the woken task on return from the
+ * interrupt. Without the switch, a task woken by the ISR waits until the
+ * next tick. The ISR runs in a \ref FreeRTOSIsrContext, so the critical
+ * sections it enters through \ref FreeRTOSOsServices use the ISR
+ * primitives. Install it in the vector table or invoke it from the vector:
+ *
+ *     extern "C" void Uart1IrqVector()
+ *     {
+ *         FreeRTOSIsrVector<IsrService<Uart1>>();
+ *     }
+ */
+template <class Service>
+void FreeRTOSIsrVector()
+{
+    bool task_woken = false;
+    {
+        FreeRTOSIsrContext context;
+        Service::ISR(task_woken);
+    }
+    portEND_SWITCHING_ISR(task_woken ? pdTRUE : pdFALSE);
+}
+
+}    // namespace djetk
+
+#endif    // FREERTOS_ISR_VECTOR_H
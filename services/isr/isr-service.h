@@ -24,6 +24,11 @@
 #ifndef ISR_SERVICE_H
 #define ISR_SERVICE_H
 
+#include <profiling/icycle-counter.h>
+#include <profiling/execution-stats.h>
+#include <profiling/isr-profile.h>
+#include <errors/icritical-error-handler.h>
+
 namespace djetk {
 
 /**
@@ -76,8 +81,8 @@ class IIsrService {
  * \param Driver    Class of driver that will register for ISR service events
  *
  * This template defines the registrable hook to an Interrupt Service Routine.
- * An instance per IRQ can be defined. The example below shows how it all ties
- * up together.
+ * An instance per IRQ can be defined. Drivers that are global objects can
+ * avoid the handler lookup and virtual call with \ref DirectIsrService.
  *
  * The example below shows how it all ties up together
  * \include isr-service-example.cpp
@@ -106,26 +111,103 @@ class IsrService : public IIsrService {
         handler_ = nullptr;
     }
 
+    /**
+     * \brief Measure the execution time of the registered handler
+     * \param[in]   cycle_counter   Clock to measure the execution time with
+     * \param[in]   stats           Statistics to record the execution times in
+     * \param[in]   error_handler   Callback to notify of budget overruns
+     *
+     * A handler exceeding the budget set in the statistics is reported with
+     * ICriticalErrorHandler::isr_budget_error. Must be invoked with the
+     * interrupt disabled.
+     */
+    void EnableAccounting(ICycleCounter &cycle_counter, ExecutionStats &stats,
+            ICriticalErrorHandler &error_handler)
+    {
+        cycle_counter_ = &cycle_counter;
+        stats_ = &stats;
+        profile_ = nullptr;
+        error_handler_ = &error_handler;
+    }
+
+    /**
+     * \brief Profile the interrupt frequency and the registered handler
+     * \param[in]   cycle_counter   Clock to measure with
+     * \param[in]   profile         Profile of this vector
+     * \param[in]   error_handler   Callback to notify of budget overruns
+     *
+     * As the other overload, recording the handler execution times in the
+     * profile along with the time between interrupts. Must be invoked with
+     * the interrupt disabled.
+     */
+    void EnableAccounting(ICycleCounter &cycle_counter, IsrProfile &profile,
+            ICriticalErrorHandler &error_handler)
+    {
+        EnableAccounting(cycle_counter, profile.GetHandlerStats(), error_handler);
+        profile_ = &profile;
+    }
+
+    /**
+     * \brief Stop measuring the execution time of the registered handler
+     */
+    void DisableAccounting()
+    {
+        cycle_counter_ = nullptr;
+    }
+
     /**
      * \brief Device Driver ISR handler
      * \param[out]  task_woken  Rescheduling required due to woken up task
      *
-     * This method is to be invoked by the IRQ vector
+     * This method is to be invoked by the IRQ vector, which must request a
+     * context switch if task_woken is set (see \ref FreeRTOSIsrVector)
      */
     static void ISR(bool &task_woken)
     {
         if (handler_) {
+            if (cycle_counter_ == nullptr) {
+                handler_->HandleIsr(task_woken);
+                return;
+            }
+
+            auto start = cycle_counter_->GetCycles();
+            if (profile_ != nullptr) {
+                profile_->RecordEntry(start);
+            }
+
             handler_->HandleIsr(task_woken);
+            auto elapsed = cycle_counter_->GetCycles() - start;
+
+            if (!stats_->Record(elapsed)) {
+                error_handler_->NotifyCriticalError(ICriticalErrorHandler::isr_budget_error,
+                    __FILE__, __LINE__);
+            }
         }
     }
 
   private:
     static IIsrHandler *handler_;
+    static ICycleCounter *cycle_counter_;
+    static ExecutionStats *stats_;
+    static IsrProfile *profile_;
+    static ICriticalErrorHandler *error_handler_;
 };
 
 template <class Driver>
 IIsrHandler *IsrService<Driver>::handler_;
 
+template <class Driver>
+ICycleCounter *IsrService<Driver>::cycle_counter_;
+
+template <class Driver>
+ExecutionStats *IsrService<Driver>::stats_;
+
+template <class Driver>
+IsrProfile *IsrService<Driver>::profile_;
+
+template <class Driver>
+ICriticalErrorHandler *IsrService<Driver>::error_handler_;
+
 }    // namespace djetk
 
 #endif    // ISR_SERVICE_H
@@ -0,0 +1,189 @@
+/**
+    \file
+    \brief ISR Service shared by several handlers
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SHARED_ISR_SERVICE_H
+#define SHARED_ISR_SERVICE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Handler of an interrupt line shared by several sources
+ *
+ * Each handler checks whether its own source raised the interrupt (e.g. the
+ * pending bit of a GPIO pin) and services it.
+ */
+class ISharedIsrHandler {
+  public:
+    /**
+     * \brief Driver specific ISR handler function
+     * \param[in,out] task_woken Set if rescheduling is required due to a
+     *                          woken up task, otherwise left as is
+     * \retval true     The interrupt was raised by this source and is handled
+     * \retval false    Not raised by this source
+     */
+    virtual bool HandleSharedIsr(bool &task_woken) = 0;
+    virtual ~ISharedIsrHandler() {}
+};
+
+/**
+ * \brief Interface of an ISR service that chains several handlers
+ */
+class ISharedIsrService {
+  public:
+    /**
+     * \brief Add a handler to the chain
+     * \param[in]   handler     Handler to add
+     * \param[in]   priority    Handlers with a higher priority are invoked
+     *                          first. Give the most frequent source the
+     *                          highest priority.
+     * \return false if the chain is full or the handler is already in it
+     */
+    virtual bool RegisterHandler(ISharedIsrHandler &handler, uint32_t priority) = 0;
+
+    /**
+     * \brief Remove a handler from the chain
+     * \param[in]   handler     Handler to remove
+     */
+    virtual void UnregisterHandler(ISharedIsrHandler &handler) = 0;
+
+    virtual ~ISharedIsrService() {}
+};
+
+/**
+ * \brief ISR Service for an interrupt line shared by several sources
+ * \param Driver    Tag of the IRQ (e.g. the driver class of the line)
+ * \param Capacity  Maximum number of handlers in the chain
+ *
+ * Handlers are invoked in priority order until one claims the interrupt,
+ * so the common source is served after a single call. A line that may have
+ * several sources pending at once still works: the interrupt fires again
+ * for the sources that weren't serviced.
+ *
+ * Handlers must be registered and unregistered with the interrupt disabled.
+ */
+template <class Driver, size_t Capacity>
+class SharedIsrService : public ISharedIsrService {
+  public:
+    /**
+     * \brief See \ref ISharedIsrService::RegisterHandler
+     */
+    virtual bool RegisterHandler(ISharedIsrHandler &handler, uint32_t priority) override
+    {
+        if (count_ == Capacity) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count_; i++) {
+            if (chain_[i].handler == &handler) {
+                return false;
+            }
+        }
+
+        // Insert after the handlers of the same or higher priority
+        auto position = count_;
+        while ((position > 0) && (chain_[position - 1].priority < priority)) {
+            chain_[position] = chain_[position - 1];
+            position--;
+        }
+
+        chain_[position].handler = &handler;
+        chain_[position].priority = priority;
+        count_++;
+        return true;
+    }
+
+    /**
+     * \brief See \ref ISharedIsrService::UnregisterHandler
+     */
+    virtual void UnregisterHandler(ISharedIsrHandler &handler) override
+    {
+        for (size_t i = 0; i < count_; i++) {
+            if (chain_[i].handler == &handler) {
+                for (size_t j = i + 1; j < count_; j++) {
+                    chain_[j - 1] = chain_[j];
+                }
+
+                count_--;
+                return;
+            }
+        }
+    }
+
+    /**
+     * \brief Get the number of interrupts no handler claimed
+     */
+    static uint32_t GetUnclaimedCount()
+    {
+        return unclaimed_;
+    }
+
+    /**
+     * \brief Device Driver ISR handler
+     * \param[in,out] task_woken Set if rescheduling is required due to a
+     *                          woken up task, otherwise left as is
+     *
+     * This method is to be invoked by the IRQ vector, which initialises
+     * task_woken (see \ref FreeRTOSIsrVector)
+     */
+    static void ISR(bool &task_woken)
+    {
+        for (size_t i = 0; i < count_; i++) {
+            if (chain_[i].handler->HandleSharedIsr(task_woken)) {
+                return;
+            }
+        }
+
+        unclaimed_++;
+    }
+
+  private:
+    /**
+     * \brief Handler in the chain
+     */
+    struct Link {
+        ISharedIsrHandler *handler;
+        uint32_t priority;
+    };
+
+    static std::array<Link, Capacity> chain_;
+    static size_t count_;
+    static uint32_t unclaimed_;
+};
+
+template <class Driver, size_t Capacity>
+std::array<typename SharedIsrService<Driver, Capacity>::Link, Capacity>
+    SharedIsrService<Driver, Capacity>::chain_;
+
+template <class Driver, size_t Capacity>
+size_t SharedIsrService<Driver, Capacity>::count_;
+
+template <class Driver, size_t Capacity>
+uint32_t SharedIsrService<Driver, Capacity>::unclaimed_;
+
+}    // namespace djetk
+
+#endif    // SHARED_ISR_SERVICE_H
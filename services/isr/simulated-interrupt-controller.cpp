@@ -0,0 +1,166 @@
+/**
+    \file
+    \brief Simulated interrupt controller implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <limits>
+#include <isr/simulated-interrupt-controller.h>
+
+namespace djetk {
+
+SimulatedIrq::SimulatedIrq(const char *name, IsrFunction isr, Distribution distribution,
+        uint32_t rate_hz, uint32_t burst_length)
+    : name_(name),
+    isr_(isr),
+    distribution_(distribution),
+    rate_hz_(rate_hz),
+    burst_length_((burst_length == 0) ? 1 : burst_length),
+    next_arrival_(0),
+    raised_at_(0),
+    raised_(0),
+    dropped_(0),
+    completed_(0),
+    cycle_counter_(nullptr),
+    next_(nullptr)
+{
+}
+
+void SimulatedIrq::RecordCompletion(uint32_t raised_at)
+{
+    completed_++;
+    if (cycle_counter_ != nullptr) {
+        latency_.Record(cycle_counter_->GetCycles() - raised_at);
+    }
+}
+
+SimulatedIrq::Report SimulatedIrq::GetReport() const
+{
+    Report report;
+    report.raised = raised_;
+    report.dropped = dropped_;
+    report.completed = completed_;
+    report.drop_permille = (raised_ == 0) ? 0 :
+        static_cast<uint32_t>((static_cast<uint64_t>(report.dropped) * 1000) / raised_);
+    report.max_latency = latency_.GetMax();
+    report.mean_latency = latency_.GetMean();
+    report.p99_latency = latency_.GetPercentile(99);
+    return report;
+}
+
+void SimulatedIrq::Reset()
+{
+    raised_ = 0;
+    dropped_ = 0;
+    completed_ = 0;
+    latency_.Reset();
+}
+
+SimulatedInterruptController::SimulatedInterruptController(ITickSource &tick_source,
+        ICycleCounter &cycle_counter, ICriticalErrorHandler &error_handler, uint32_t seed)
+    : cycle_counter_(cycle_counter),
+    irqs_(nullptr),
+    ticks_per_second_(tick_source.MsToTicks(1000)),
+    load_percent_(100),
+    running_(false),
+    tick_(0),
+    random_state_((seed == 0) ? 1 : seed)
+{
+    if (!tick_source.RegisterTickClient(*this)) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
+                __FILE__, __LINE__);
+    }
+}
+
+void SimulatedInterruptController::AddIrq(SimulatedIrq &irq)
+{
+    irq.cycle_counter_ = &cycle_counter_;
+    irq.next_ = irqs_;
+    irqs_ = &irq;
+}
+
+void SimulatedInterruptController::Start()
+{
+    tick_ = 0;
+    for (auto irq = irqs_; irq != nullptr; irq = irq->next_) {
+        ScheduleNext(*irq, true);
+    }
+
+    running_ = true;
+}
+
+bool SimulatedInterruptController::OnTickFromIsr(bool &task_woken)
+{
+    if (!running_) {
+        return true;
+    }
+
+    tick_++;
+    for (auto irq = irqs_; irq != nullptr; irq = irq->next_) {
+        while (irq->next_arrival_ <= tick_) {
+            // A burst raises all its interrupts back to back
+            auto count = (irq->distribution_ == SimulatedIrq::Distribution::burst) ?
+                irq->burst_length_ : 1;
+            for (uint32_t i = 0; i < count; i++) {
+                bool isr_task_woken = false;
+                irq->raised_at_ = cycle_counter_.GetCycles();
+                irq->raised_++;
+                irq->isr_(isr_task_woken);
+                task_woken = task_woken || isr_task_woken;
+            }
+
+            ScheduleNext(*irq, false);
+        }
+    }
+
+    return true;
+}
+
+void SimulatedInterruptController::ScheduleNext(SimulatedIrq &irq, bool first)
+{
+    // Mean ticks between arrivals (or bursts) at the current load
+    auto rate = (static_cast<double>(irq.rate_hz_) * load_percent_) / 100;
+    if (rate <= 0) {
+        // Never arrives
+        irq.next_arrival_ = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    auto interval = ticks_per_second_ / rate;
+    if (irq.distribution_ == SimulatedIrq::Distribution::burst) {
+        interval *= irq.burst_length_;
+    } else if (irq.distribution_ == SimulatedIrq::Distribution::poisson) {
+        interval *= -std::log(Random());
+    }
+
+    irq.next_arrival_ = (first ? 0 : irq.next_arrival_) + interval;
+}
+
+double SimulatedInterruptController::Random()
+{
+    // xorshift32, which is cheap enough for the tick interrupt
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 17;
+    random_state_ ^= random_state_ << 5;
+    return (static_cast<double>(random_state_) + 1) / 4294967296.0;
+}
+
+}    // namespace djetk
@@ -0,0 +1,271 @@
+/**
+    \file
+    \brief Simulated interrupt controller for load testing ISR paths
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIMULATED_INTERRUPT_CONTROLLER_H
+#define SIMULATED_INTERRUPT_CONTROLLER_H
+
+#include <cstdint>
+#include <timing/itick-client.h>
+#include <timing/itick-source.h>
+#include <profiling/icycle-counter.h>
+#include <profiling/execution-stats.h>
+#include <errors/icritical-error-handler.h>
+
+namespace djetk {
+
+/**
+ * \brief Virtual interrupt source of a \ref SimulatedInterruptController
+ *
+ * Each arrival invokes the ISR of the source (e.g. IsrService<Driver>::ISR)
+ * from the tick interrupt. To measure the end-to-end latency of the ISR to
+ * task pipeline:
+ * - the ISR reads \ref GetRaisedAt and passes it along with the event
+ * - the task that finishes handling the event invokes \ref RecordCompletion
+ * - the ISR invokes \ref RecordDrop if it can't pass the event on (e.g. the
+ *   queue is full)
+ */
+class SimulatedIrq {
+  public:
+    /**
+     * \brief ISR entry point, as IsrService::ISR
+     */
+    typedef void (*IsrFunction)(bool &task_woken);
+
+    /**
+     * \brief Distribution of the arrivals
+     */
+    enum class Distribution {
+        /**
+         * \brief Evenly spaced arrivals
+         */
+        periodic,
+
+        /**
+         * \brief Exponentially distributed times between arrivals
+         */
+        poisson,
+
+        /**
+         * \brief Groups of back to back arrivals
+         */
+        burst
+    };
+
+    /**
+     * \brief Results of a load test
+     */
+    struct Report {
+        /**
+         * \brief Number of interrupts raised
+         */
+        uint32_t raised;
+
+        /**
+         * \brief Number of events the ISR dropped
+         */
+        uint32_t dropped;
+
+        /**
+         * \brief Number of events handled by the task
+         */
+        uint32_t completed;
+
+        /**
+         * \brief Drop rate in tenths of a percent of the raised interrupts
+         */
+        uint32_t drop_permille;
+
+        /**
+         * \brief Latency from raising the interrupt to completion, in cycles
+         */
+        uint32_t max_latency;
+        uint32_t mean_latency;
+        uint32_t p99_latency;
+    };
+
+    /**
+     * \brief Construct an interrupt source
+     * \param[in]   name            Name of the source
+     * \param[in]   isr             ISR to invoke on each arrival
+     * \param[in]   distribution    Distribution of the arrivals
+     * \param[in]   rate_hz         Mean number of arrivals per second at 100% load
+     * \param[in]   burst_length    Arrivals per burst (\ref Distribution::burst only)
+     */
+    SimulatedIrq(const char *name, IsrFunction isr, Distribution distribution,
+            uint32_t rate_hz, uint32_t burst_length = 1);
+
+    /**
+     * \brief Get the cycle count when the interrupt being serviced was raised
+     *
+     * Only valid from within the ISR.
+     */
+    uint32_t GetRaisedAt() const
+    {
+        return raised_at_;
+    }
+
+    /**
+     * \brief Count an event that the ISR couldn't pass on
+     */
+    void RecordDrop()
+    {
+        dropped_++;
+    }
+
+    /**
+     * \brief Record the completion of an event by the task
+     * \param[in]   raised_at   Value of \ref GetRaisedAt when the event was raised
+     */
+    void RecordCompletion(uint32_t raised_at);
+
+    /**
+     * \brief Get the results since the last \ref Reset
+     */
+    Report GetReport() const;
+
+    /**
+     * \brief Clear the results
+     */
+    void Reset();
+
+    /**
+     * \brief Get the name of the source
+     */
+    const char *GetName() const
+    {
+        return name_;
+    }
+
+  private:
+    friend class SimulatedInterruptController;
+
+    SimulatedIrq(const SimulatedIrq &rhs);
+    const SimulatedIrq& operator=(const SimulatedIrq &rhs);
+
+    const char *name_;
+    IsrFunction isr_;
+    Distribution distribution_;
+    uint32_t rate_hz_;
+    uint32_t burst_length_;
+
+    double next_arrival_;
+    uint32_t raised_at_;
+    uint32_t raised_;
+    volatile uint32_t dropped_;
+    uint32_t completed_;
+    ExecutionStats latency_;
+    ICycleCounter *cycle_counter_;
+    SimulatedIrq *next_;
+};
+
+/**
+ * \brief Interrupt controller that raises virtual interrupts for load testing
+ *
+ * On the POSIX simulator, ISRs otherwise only run when invoked by hand. This
+ * controller is driven by the tick interrupt and invokes the ISRs of its
+ * sources at their configured rates, so ISR to task pipelines can be tested
+ * under realistic load.
+ *
+ * - Arrivals are resolved to the tick. All arrivals that fall within a tick
+ *   are raised back to back on that tick.
+ * - The task_woken result of every ISR is passed on to the tick source,
+ *   which reschedules at the end of the tick interrupt
+ * - \ref SetLoadPercent scales all the rates, to sweep the load levels. Reset
+ *   the sources between levels and read their reports after each.
+ * - The controller is idle until \ref Start is invoked
+ *
+ * The tick source must actually tick. \ref FreeRTOSTickHookTimer only does
+ * so with configUSE_TICK_HOOK set, which the POSIX test configuration
+ * doesn't, so the tests drive the controller with a stub tick source.
+ */
+class SimulatedInterruptController : private ITickClient {
+  public:
+    /**
+     * \brief Construct a controller
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   cycle_counter   Clock to time stamp the interrupts with
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   seed            Seed of the random arrivals
+     */
+    SimulatedInterruptController(ITickSource &tick_source, ICycleCounter &cycle_counter,
+            ICriticalErrorHandler &error_handler, uint32_t seed = 1);
+
+    /**
+     * \brief Add an interrupt source
+     *
+     * Must be invoked while the controller is stopped.
+     */
+    void AddIrq(SimulatedIrq &irq);
+
+    /**
+     * \brief Scale the rates of all the sources
+     * \param[in]   percent     Load level, 100 being the configured rates
+     *
+     * Must be invoked while the controller is stopped.
+     */
+    void SetLoadPercent(uint32_t percent)
+    {
+        load_percent_ = percent;
+    }
+
+    /**
+     * \brief Start raising interrupts from the next tick
+     */
+    void Start();
+
+    /**
+     * \brief Stop raising interrupts
+     */
+    void Stop()
+    {
+        running_ = false;
+    }
+
+  private:
+    /**
+     * \brief See \ref ITickClient::OnTickFromIsr
+     */
+    virtual bool OnTickFromIsr(bool &task_woken) override;
+
+    /**
+     * \brief Schedule the next arrival of a source
+     */
+    void ScheduleNext(SimulatedIrq &irq, bool first);
+
+    /**
+     * \brief Get a uniformly distributed random number in (0, 1]
+     */
+    double Random();
+
+    ICycleCounter &cycle_counter_;
+    SimulatedIrq *irqs_;
+    uint32_t ticks_per_second_;
+    uint32_t load_percent_;
+    volatile bool running_;
+    uint32_t tick_;
+    uint32_t random_state_;
+};
+
+}    // namespace djetk
+
+#endif    // SIMULATED_INTERRUPT_CONTROLLER_H
@@ -0,0 +1,427 @@
+/**
+    \file
+    \brief ISR service tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <isr/shared-isr-service.h>
+#include <isr/isr-service.h>
+#include <isr/direct-isr-service.h>
+#include <isr/simulated-interrupt-controller.h>
+#include <testing/tick-generator-stub.h>
+#include <testing/cycle-counter-stub.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Shared ISR handler stub
+ */
+class SharedIsrHandlerStub : public ISharedIsrHandler {
+  public:
+    explicit SharedIsrHandlerStub(uint32_t &call_log, uint32_t id)
+        : pending(false),
+        isr_count(0),
+        call_log_(call_log),
+        id_(id)
+    {
+    }
+
+    virtual bool HandleSharedIsr(bool &task_woken) override
+    {
+        // Record the call order as a sequence of digits
+        call_log_ = (call_log_ * 10) + id_;
+        if (!pending) {
+            return false;
+        }
+
+        pending = false;
+        task_woken = true;
+        isr_count++;
+        return true;
+    }
+
+    /**
+     * \brief Whether this source raised the interrupt
+     */
+    bool pending;
+
+    /**
+     * \brief Number of interrupts claimed
+     */
+    uint32_t isr_count;
+
+  private:
+    uint32_t &call_log_;
+    uint32_t id_;
+};
+
+/**
+ * \brief Tag for the \ref SharedIsrService under test
+ */
+class TestSharedLine;
+
+typedef SharedIsrService<TestSharedLine, 3> TestSharedIsrService;
+
+/**
+ * \test Test that handlers run in priority order and the chain stops at the claiming handler
+ */
+void test_SharedIsr_ClaimedByHandler_StopsChainInPriorityOrder()
+{
+    TestSharedIsrService isr_service;
+    uint32_t call_log = 0;
+    SharedIsrHandlerStub low(call_log, 1);
+    SharedIsrHandlerStub high(call_log, 2);
+    SharedIsrHandlerStub medium(call_log, 3);
+
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(low, 1));
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(high, 10));
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(medium, 5));
+
+    // The highest priority handler claims, so no other handler is invoked
+    bool task_woken = false;
+    high.pending = true;
+    TestSharedIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(2, call_log);
+    TEST_ASSERT_TRUE(task_woken);
+
+    call_log = 0;
+    medium.pending = true;
+    TestSharedIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(23, call_log);
+    TEST_ASSERT_EQUAL(1, medium.isr_count);
+
+    // Nobody claims
+    call_log = 0;
+    task_woken = false;
+    TestSharedIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(231, call_log);
+    TEST_ASSERT_FALSE(task_woken);
+    TEST_ASSERT_EQUAL(1, TestSharedIsrService::GetUnclaimedCount());
+
+    // A wake-up reported earlier in the same interrupt is kept
+    task_woken = true;
+    TestSharedIsrService::ISR(task_woken);
+    TEST_ASSERT_TRUE(task_woken);
+
+    isr_service.UnregisterHandler(low);
+    isr_service.UnregisterHandler(high);
+    isr_service.UnregisterHandler(medium);
+}
+
+/**
+ * \test Test that registration fails once the chain is full or for duplicates
+ */
+void test_RegisterHandler_FullChainOrDuplicate_Fails()
+{
+    TestSharedIsrService isr_service;
+    uint32_t call_log = 0;
+    SharedIsrHandlerStub a(call_log, 1);
+    SharedIsrHandlerStub b(call_log, 2);
+    SharedIsrHandlerStub c(call_log, 3);
+    SharedIsrHandlerStub d(call_log, 4);
+
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(a, 0));
+    TEST_ASSERT_FALSE(isr_service.RegisterHandler(a, 0));
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(b, 0));
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(c, 0));
+    TEST_ASSERT_FALSE(isr_service.RegisterHandler(d, 0));
+
+    // Equal priorities keep the registration order, and unregistering frees a link
+    isr_service.UnregisterHandler(b);
+    TEST_ASSERT_TRUE(isr_service.RegisterHandler(d, 0));
+
+    bool task_woken = false;
+    TestSharedIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(134, call_log);
+
+    isr_service.UnregisterHandler(a);
+    isr_service.UnregisterHandler(c);
+    isr_service.UnregisterHandler(d);
+}
+
+/**
+ * \brief Driver stub bound to a \ref DirectIsrService
+ *
+ * Not derived from \ref IIsrHandler, as the service calls it directly.
+ */
+class DirectDriverStub {
+  public:
+    DirectDriverStub()
+        : wakes_task(false),
+        isr_count(0)
+    {
+    }
+
+    void HandleIsr(bool &task_woken)
+    {
+        isr_count++;
+        if (wakes_task) {
+            task_woken = true;
+        }
+    }
+
+    /**
+     * \brief Whether the next interrupt wakes a task
+     */
+    bool wakes_task;
+
+    /**
+     * \brief Number of interrupts handled
+     */
+    uint32_t isr_count;
+};
+
+/**
+ * \brief Driver instance the \ref DirectIsrService under test is bound to.
+ *        Template arguments need an object with external linkage.
+ */
+DirectDriverStub direct_driver;
+
+typedef DirectIsrService<DirectDriverStub, direct_driver> TestDirectIsrService;
+
+/**
+ * \test Test that the vector reaches the bound driver and passes task_woken back
+ */
+void test_DirectIsr_DriverBound_HandlesIsrAndPropagatesTaskWoken()
+{
+    direct_driver = DirectDriverStub();
+
+    bool task_woken = false;
+    TestDirectIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(1, direct_driver.isr_count);
+    TEST_ASSERT_FALSE(task_woken);
+
+    direct_driver.wakes_task = true;
+    TestDirectIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(2, direct_driver.isr_count);
+    TEST_ASSERT_TRUE(task_woken);
+
+    // A driver that doesn't wake a task leaves an earlier wake up in place
+    direct_driver.wakes_task = false;
+    TestDirectIsrService::ISR(task_woken);
+    TEST_ASSERT_EQUAL(3, direct_driver.isr_count);
+    TEST_ASSERT_TRUE(task_woken);
+}
+
+/**
+ * \brief Driver that passes events from its ISR to a task through a bounded queue
+ */
+class SimulatedDriver : public IIsrHandler {
+  public:
+    SimulatedDriver()
+        : irq(nullptr),
+        count(0),
+        head(0)
+    {
+    }
+
+    virtual void HandleIsr(bool &task_woken) override
+    {
+        if (count == kCapacity) {
+            irq->RecordDrop();
+            return;
+        }
+
+        events[(head + count) % kCapacity] = irq->GetRaisedAt();
+        count++;
+        task_woken = true;
+    }
+
+    /**
+     * \brief Handle up to max_events events as the task would
+     */
+    void RunTask(uint32_t max_events)
+    {
+        while ((count > 0) && (max_events-- > 0)) {
+            irq->RecordCompletion(events[head]);
+            head = (head + 1) % kCapacity;
+            count--;
+        }
+    }
+
+    static constexpr uint32_t kCapacity = 4;
+    SimulatedIrq *irq;
+    uint32_t events[kCapacity];
+    uint32_t count;
+    uint32_t head;
+};
+
+typedef IsrService<SimulatedDriver> SimulatedIsrService;
+
+/**
+ * \brief Container class to construct a simulated interrupt controller
+ */
+class TestSimulatedInterruptControllerContainer {
+  public:
+    TestSimulatedInterruptControllerContainer(SimulatedIrq::Distribution distribution,
+            uint32_t rate_hz, uint32_t burst_length = 1)
+        : controller(tick_source, cycle_counter, error_handler),
+        irq("test", SimulatedIsrService::ISR, distribution, rate_hz, burst_length)
+    {
+        driver.irq = &irq;
+        isr_service.RegisterHandler(driver);
+        controller.AddIrq(irq);
+    }
+
+    ~TestSimulatedInterruptControllerContainer()
+    {
+        isr_service.UnregisterHandler();
+    }
+
+    /**
+     * \brief Run one second of simulated time (one tick per millisecond)
+     * \param[in]   events_per_tick Number of events the task handles per tick
+     * \return Number of ticks that woke the task
+     */
+    uint32_t RunOneSecond(uint32_t events_per_tick)
+    {
+        uint32_t wakeups = 0;
+        for (uint32_t tick = 0; tick < 1000; tick++) {
+            cycle_counter.cycles += 1000;
+            if (tick_source.Tick()) {
+                wakeups++;
+            }
+
+            driver.RunTask(events_per_tick);
+        }
+
+        return wakeups;
+    }
+
+    /**
+     * \privatesection Test container injected stubs
+     */
+    TickGeneratorStub tick_source;
+    CycleCounterStub cycle_counter;
+    CriticalErrorHandlerStub error_handler;
+    SimulatedInterruptController controller;
+    SimulatedIsrService isr_service;
+    SimulatedDriver driver;
+    SimulatedIrq irq;
+};
+
+/**
+ * \test Test that periodic interrupts are raised at their rate and wake the task
+ */
+void test_SimulatedIrq_Periodic_RaisedAtRate()
+{
+    TestSimulatedInterruptControllerContainer container(SimulatedIrq::Distribution::periodic, 250);
+
+    // Nothing is raised until started
+    container.RunOneSecond(1);
+    TEST_ASSERT_EQUAL(0, container.irq.GetReport().raised);
+
+    container.controller.Start();
+    TEST_ASSERT_EQUAL(250, container.RunOneSecond(1));
+
+    auto report = container.irq.GetReport();
+    TEST_ASSERT_EQUAL(250, report.raised);
+    TEST_ASSERT_EQUAL(250, report.completed);
+    TEST_ASSERT_EQUAL(0, report.dropped);
+    TEST_ASSERT_EQUAL(0, report.max_latency);
+}
+
+/**
+ * \test Test that Poisson arrivals average out to their rate
+ */
+void test_SimulatedIrq_Poisson_MeanRateWithinTolerance()
+{
+    TestSimulatedInterruptControllerContainer container(SimulatedIrq::Distribution::poisson, 200);
+
+    container.controller.Start();
+    for (int i = 0; i < 10; i++) {
+        container.RunOneSecond(SimulatedDriver::kCapacity);
+    }
+
+    // 2000 expected arrivals have a standard deviation of about 45
+    auto raised = container.irq.GetReport().raised;
+    TEST_ASSERT_TRUE(raised > 1800);
+    TEST_ASSERT_TRUE(raised < 2200);
+}
+
+/**
+ * \test Test that bursts overflow the queue and the drops and latencies are reported
+ */
+void test_SimulatedIrq_Burst_DropsAndLatencyReported()
+{
+    // Bursts of 6 every 60 ticks into a queue of 4 drained one event per tick
+    TestSimulatedInterruptControllerContainer container(SimulatedIrq::Distribution::burst, 100, 6);
+
+    container.controller.Start();
+    container.RunOneSecond(1);
+
+    auto report = container.irq.GetReport();
+    TEST_ASSERT_EQUAL(96, report.raised);
+    TEST_ASSERT_EQUAL(32, report.dropped);
+    TEST_ASSERT_EQUAL(64, report.completed);
+    TEST_ASSERT_EQUAL(333, report.drop_permille);
+
+    // The last event of a burst waits three ticks for the task
+    TEST_ASSERT_EQUAL(3000, report.max_latency);
+}
+
+/**
+ * \test Test that the load level scales the rates for a load sweep
+ */
+void test_SetLoadPercent_LoadSweep_ScalesRateAndDrops()
+{
+    TestSimulatedInterruptControllerContainer container(SimulatedIrq::Distribution::periodic, 500);
+
+    // The task keeps up with one event every other tick
+    const uint32_t loads[] = { 0, 50, 100, 200 };
+    const uint32_t expected_raised[] = { 0, 250, 500, 1000 };
+    for (size_t i = 0; i < 4; i++) {
+        container.controller.Stop();
+        container.irq.Reset();
+        container.controller.SetLoadPercent(loads[i]);
+        container.controller.Start();
+        for (uint32_t tick = 0; tick < 1000; tick++) {
+            container.tick_source.Tick();
+            container.driver.RunTask(tick % 2);
+        }
+
+        auto report = container.irq.GetReport();
+        TEST_ASSERT_EQUAL(expected_raised[i], report.raised);
+        if (loads[i] <= 100) {
+            TEST_ASSERT_EQUAL(0, report.dropped);
+        } else {
+            TEST_ASSERT_TRUE(report.drop_permille > 400);
+        }
+    }
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_SharedIsr_ClaimedByHandler_StopsChainInPriorityOrder);
+    RUN_TEST(test_RegisterHandler_FullChainOrDuplicate_Fails);
+    RUN_TEST(test_DirectIsr_DriverBound_HandlesIsrAndPropagatesTaskWoken);
+    RUN_TEST(test_SimulatedIrq_Periodic_RaisedAtRate);
+    RUN_TEST(test_SimulatedIrq_Poisson_MeanRateWithinTolerance);
+    RUN_TEST(test_SimulatedIrq_Burst_DropsAndLatencyReported);
+    RUN_TEST(test_SetLoadPercent_LoadSweep_ScalesRateAndDrops);
+    return UnityEnd();
+}
@@ -0,0 +1,44 @@
+/**
+    \file
+    \brief FreeRTOS job system worker task implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <jobs/freertos-job-worker.h>
+
+namespace djetk {
+
+FreeRTOSJobWorker::FreeRTOSJobWorker(ICriticalErrorHandler &error_handler,
+        const signed char *name, unsigned short stack_depth,
+        unsigned portBASE_TYPE priority, JobSystem &job_system, size_t worker)
+    : FreeRTOSTaskBase(error_handler, name, stack_depth, priority),
+    job_system_(job_system),
+    worker_(worker)
+{
+}
+
+void FreeRTOSJobWorker::TaskMain()
+{
+    for (;;) {
+        job_system_.RunWorker(worker_);
+    }
+}
+
+}    // namespace djetk
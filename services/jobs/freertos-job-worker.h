@@ -0,0 +1,68 @@
+/**
+    \file
+    \brief FreeRTOS job system worker task
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_JOB_WORKER_H
+#define FREERTOS_JOB_WORKER_H
+
+#include <cstddef>
+#include <jobs/job-system.h>
+#include <threads/freertos-task-base.h>
+
+namespace djetk {
+
+/**
+ * \brief FreeRTOS task that runs the jobs of a \ref JobSystem
+ *
+ * One worker is created per deque of the job system. Workers are usually
+ * given a lower priority than the tasks that submit jobs, so the submitter
+ * runs jobs itself while it waits and the workers pick up the rest whenever
+ * the submitter blocks.
+ */
+class FreeRTOSJobWorker : public FreeRTOSTaskBase {
+  public:
+    /**
+     * \brief Create the worker task
+     * \param[in]   error_handler   Reference to application specific error handler
+     * \param[in]   name            Task name used by FreeRTOS
+     * \param[in]   stack_depth     Stack depth as required by FreeRTOS
+     * \param[in]   priority        FreeRTOS task priority
+     * \param[in]   job_system      Job system to run the jobs of
+     * \param[in]   worker          Index of the worker's deque
+     */
+    FreeRTOSJobWorker(ICriticalErrorHandler &error_handler, const signed char *name,
+            unsigned short stack_depth, unsigned portBASE_TYPE priority,
+            JobSystem &job_system, size_t worker);
+
+  private:
+    /**
+     * \brief See \ref FreeRTOSTaskBase::TaskMain
+     */
+    virtual void TaskMain() override;
+
+    JobSystem &job_system_;
+    size_t worker_;
+};
+
+}    // namespace djetk
+
+#endif    // FREERTOS_JOB_WORKER_H
@@ -0,0 +1,69 @@
+/**
+    \file
+    \brief Job deque implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <jobs/job-deque.h>
+
+namespace djetk {
+
+JobDeque::JobDeque(JobList &buffer)
+    : buffer_(buffer),
+    top_(0),
+    count_(0)
+{
+}
+
+bool JobDeque::PushBottom(const Job &job)
+{
+    if (count_ == buffer_.size()) {
+        return false;
+    }
+
+    buffer_.data()[(top_ + count_) % buffer_.size()] = job;
+    count_++;
+    return true;
+}
+
+bool JobDeque::PopBottom(Job &job)
+{
+    if (count_ == 0) {
+        return false;
+    }
+
+    count_--;
+    job = buffer_.data()[(top_ + count_) % buffer_.size()];
+    return true;
+}
+
+bool JobDeque::StealTop(Job &job)
+{
+    if (count_ == 0) {
+        return false;
+    }
+
+    job = buffer_.data()[top_];
+    top_ = (top_ + 1) % buffer_.size();
+    count_--;
+    return true;
+}
+
+}    // namespace djetk
@@ -0,0 +1,92 @@
+/**
+    \file
+    \brief Job deque definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JOB_DEQUE_H
+#define JOB_DEQUE_H
+
+#include <cstddef>
+#include <jobs/job.h>
+#include <utilities/buffptr.h>
+
+namespace djetk {
+
+/**
+ * \brief Fixed capacity double ended queue of jobs
+ *
+ * The owning worker pushes and pops jobs at the bottom (LIFO, which keeps
+ * recently split work cache warm) while other workers steal from the top
+ * (FIFO, which hands out the largest remaining pieces of work).
+ *
+ * The deque isn't thread safe by itself. \ref JobSystem serialises access.
+ */
+class JobDeque {
+  public:
+    /**
+     * \brief Construct an empty deque
+     * \param[in]   buffer  Storage for the queued jobs
+     */
+    explicit JobDeque(JobList &buffer);
+
+    /**
+     * \brief Queue a job at the bottom
+     * \param[in]   job     Job to queue
+     * \return false if the deque is full
+     */
+    bool PushBottom(const Job &job);
+
+    /**
+     * \brief Take the most recently queued job
+     * \param[out]  job     Dequeued job
+     * \return false if the deque is empty
+     */
+    bool PopBottom(Job &job);
+
+    /**
+     * \brief Take the least recently queued job
+     * \param[out]  job     Dequeued job
+     * \return false if the deque is empty
+     */
+    bool StealTop(Job &job);
+
+    /**
+     * \brief Get the number of queued jobs
+     */
+    size_t GetCount() const
+    {
+        return count_;
+    }
+
+  private:
+    JobList &buffer_;
+    size_t top_;
+    size_t count_;
+};
+
+/**
+ * \brief Buffer pointer to a list (array) of job deques
+ */
+typedef buffptr<JobDeque> JobDequeList;
+
+}    // namespace djetk
+
+#endif    // JOB_DEQUE_H
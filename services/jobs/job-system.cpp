@@ -0,0 +1,186 @@
+/**
+    \file
+    \brief Work stealing job system implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <jobs/job-system.h>
+#include <timing/freertos-ticks.h>
+
+namespace djetk {
+
+JobSystem::JobSystem(JobDequeList &deques, IMessageQueue &wake_queue,
+        IMessageQueue &done_queue, IOsServices &os_services)
+    : deques_(deques),
+    wake_queue_(wake_queue),
+    done_queue_(done_queue),
+    os_services_(os_services),
+    next_deque_(0),
+    steal_count_(0),
+    inline_count_(0)
+{
+}
+
+void JobSystem::Submit(JobFunction function, void *context, uint32_t begin,
+        uint32_t end, WaitGroup &group)
+{
+    Job job = { function, context, begin, end, &group };
+
+    bool queued = false;
+    {
+        AutoInterruptDisabler lock(os_services_);
+        group.pending_++;
+
+        // Start with the next deque in turn and fall back to the others
+        for (size_t i = 0; (i < deques_.size()) && !queued; i++) {
+            auto &deque = deques_.data()[next_deque_];
+            next_deque_ = (next_deque_ + 1) % deques_.size();
+            queued = deque.PushBottom(job);
+        }
+
+        if (!queued) {
+            inline_count_++;
+        }
+    }
+
+    if (queued) {
+        Wake();
+    } else {
+        Execute(job);
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain, JobFunction function,
+        void *context)
+{
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    // Without workers, there's nobody to share with
+    if (deques_.size() == 0) {
+        function(context, 0, count);
+        return;
+    }
+
+    WaitGroup group;
+    for (uint32_t begin = 0; begin < count; ) {
+        auto end = ((count - begin) > grain) ? (begin + grain) : count;
+        Submit(function, context, begin, end, group);
+        begin = end;
+    }
+
+    Wait(group);
+}
+
+void JobSystem::Wait(WaitGroup &group)
+{
+    for (;;) {
+        if (RunJob(deques_.size())) {
+            continue;
+        }
+
+        // The remaining jobs are running on workers. The check and the flag
+        // are atomic with respect to the completion of the last job, so the
+        // completion is either seen here or posted to the done queue.
+        {
+            AutoInterruptDisabler lock(os_services_);
+            if (group.IsDone()) {
+                return;
+            }
+            group.waiting_ = true;
+        }
+
+        Message msg;
+        done_queue_.ReceiveMessage(infinite_ms, msg);
+    }
+}
+
+bool JobSystem::RunJob(size_t worker)
+{
+    Job job;
+    if (!TakeJob(worker, job)) {
+        return false;
+    }
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::RunWorker(size_t worker)
+{
+    if (!RunJob(worker)) {
+        Message msg;
+        wake_queue_.ReceiveMessage(infinite_ms, msg);
+    }
+}
+
+bool JobSystem::TakeJob(size_t worker, Job &job)
+{
+    AutoInterruptDisabler lock(os_services_);
+
+    auto worker_count = deques_.size();
+    if ((worker < worker_count) && deques_.data()[worker].PopBottom(job)) {
+        return true;
+    }
+
+    // Steal from the other workers, starting with the next one along so
+    // that thieves spread over the victims
+    for (size_t i = 1; i <= worker_count; i++) {
+        auto victim = (worker + i) % worker_count;
+        if ((victim != worker) && deques_.data()[victim].StealTop(job)) {
+            if (worker < worker_count) {
+                steal_count_++;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::Execute(const Job &job)
+{
+    job.function(job.context, job.begin, job.end);
+
+    // The group may be destroyed as soon as its waiter is woken, so it isn't
+    // touched after the lock is released
+    bool wake_waiter;
+    {
+        AutoInterruptDisabler lock(os_services_);
+        auto &group = *job.group;
+        wake_waiter = (--group.pending_ == 0) && group.waiting_;
+        if (wake_waiter) {
+            group.waiting_ = false;
+        }
+    }
+
+    // There's at most one waiter, so the post can't fail
+    if (wake_waiter) {
+        done_queue_.PostMessage(Message(kWakeMessageId, static_cast<size_t>(0)), infinite_ms);
+    }
+}
+
+void JobSystem::Wake()
+{
+    wake_queue_.PostMessage(Message(kWakeMessageId, static_cast<size_t>(0)), 0);
+}
+
+}    // namespace djetk
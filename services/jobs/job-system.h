@@ -0,0 +1,184 @@
+/**
+    \file
+    \brief Work stealing job system definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <jobs/job.h>
+#include <jobs/job-deque.h>
+#include <jobs/wait-group.h>
+#include <messaging/imessage-queue.h>
+#include <os/ios-services.h>
+
+namespace djetk {
+
+/**
+ * \brief Work stealing job system
+ *
+ * Each worker owns a \ref JobDeque. A worker runs the jobs of its own deque
+ * and, once that is empty, steals from the other deques. Jobs submitted from
+ * outside the workers are spread over the deques in turn.
+ *
+ * - Workers are driven by \ref RunWorker (see \ref FreeRTOSJobWorker)
+ * - A task that waits on a \ref WaitGroup runs queued jobs while it waits,
+ *   so on a single core most of the work is done in the waiting task
+ *   without any context switches.
+ * - Jobs that don't fit the deques are run by the submitting task.
+ * - Idle workers block on the wake queue until a message is posted to it
+ *   when a job is queued. Failure to post is ignored as it means a wake up
+ *   is already pending, and a woken worker runs jobs until none are left
+ *   before blocking again.
+ * - A waiter blocks on the done queue, which only waiters receive from, so
+ *   a completion can't be consumed by an idle worker. A message is posted
+ *   when the last job of a group completes while its waiter is blocked.
+ * - Only one task may wait at a time, which also means jobs must not wait
+ *   for other jobs.
+ * - The deques are accessed with interrupts disabled, so jobs must not be
+ *   submitted from ISRs.
+ */
+class JobSystem {
+  public:
+    /**
+     * \brief Message ID posted to the wake queue
+     */
+    static constexpr uint32_t kWakeMessageId = 0x4a4f4253;
+
+    /**
+     * \brief Construct the job system
+     * \param[in]   deques          One deque per worker
+     * \param[in]   wake_queue      Queue used to wake up idle workers
+     * \param[in]   done_queue      Queue used to wake up the waiter. Must hold
+     *                              at least one message.
+     * \param[in]   os_services     OS services used to serialise deque access
+     */
+    JobSystem(JobDequeList &deques, IMessageQueue &wake_queue, IMessageQueue &done_queue,
+            IOsServices &os_services);
+
+    /**
+     * \brief Get the number of workers
+     */
+    size_t GetWorkerCount() const
+    {
+        return deques_.size();
+    }
+
+    /**
+     * \brief Queue a job
+     * \param[in]   function    Function to execute
+     * \param[in]   context     Argument passed to the function
+     * \param[in]   begin       First index of the range to process
+     * \param[in]   end         One past the last index of the range to process
+     * \param[in]   group       Group to notify when the job completes
+     *
+     * If all the deques are full, the job is executed before returning.
+     */
+    void Submit(JobFunction function, void *context, uint32_t begin, uint32_t end,
+            WaitGroup &group);
+
+    /**
+     * \brief Process a range of indices in parallel and wait for completion
+     * \param[in]   count       Number of indices to process
+     * \param[in]   grain       Maximum number of indices per job
+     * \param[in]   function    Function to execute
+     * \param[in]   context     Argument passed to the function
+     *
+     * The range [0, count) is split into jobs of up to grain indices.
+     */
+    void ParallelFor(uint32_t count, uint32_t grain, JobFunction function, void *context);
+
+    /**
+     * \brief Wait for the jobs of a group to complete
+     * \param[in]   group   Group to wait for
+     *
+     * Queued jobs are executed by the calling task while waiting. Once none
+     * are left, the task blocks on the done queue until the jobs running on
+     * the workers complete.
+     */
+    void Wait(WaitGroup &group);
+
+    /**
+     * \brief Run a single queued job
+     * \param[in]   worker  Index of the calling worker. Any value past the
+     *              last worker may be used by tasks that aren't workers.
+     * \return false if there were no jobs to run
+     *
+     * The worker's own deque is tried first. Otherwise a job is stolen from
+     * another deque.
+     */
+    bool RunJob(size_t worker);
+
+    /**
+     * \brief Worker loop iteration
+     * \param[in]   worker  Index of the calling worker
+     *
+     * Runs a job, or blocks on the wake queue if there's nothing to do.
+     */
+    void RunWorker(size_t worker);
+
+    /**
+     * \brief Get the number of jobs taken from another worker's deque
+     */
+    uint32_t GetStealCount() const
+    {
+        return steal_count_;
+    }
+
+    /**
+     * \brief Get the number of jobs run by the submitter because the deques
+     *        were full
+     */
+    uint32_t GetInlineCount() const
+    {
+        return inline_count_;
+    }
+
+  private:
+    /**
+     * \brief Take a job, preferring the worker's own deque
+     */
+    bool TakeJob(size_t worker, Job &job);
+
+    /**
+     * \brief Execute a job and notify its group
+     */
+    void Execute(const Job &job);
+
+    /**
+     * \brief Wake up a blocked worker
+     */
+    void Wake();
+
+    JobDequeList &deques_;
+    IMessageQueue &wake_queue_;
+    IMessageQueue &done_queue_;
+    IOsServices &os_services_;
+    size_t next_deque_;
+    uint32_t steal_count_;
+    uint32_t inline_count_;
+};
+
+}    // namespace djetk
+
+#endif    // JOB_SYSTEM_H
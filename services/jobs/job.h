@@ -0,0 +1,82 @@
+/**
+    \file
+    \brief Job definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef JOB_H
+#define JOB_H
+
+#include <cstdint>
+#include <utilities/buffptr.h>
+
+namespace djetk {
+
+class WaitGroup;
+
+/**
+ * \brief Job entry point
+ * \param[in]   context Job specific context
+ * \param[in]   begin   First index of the range to process
+ * \param[in]   end     One past the last index of the range to process
+ */
+typedef void (*JobFunction)(void *context, uint32_t begin, uint32_t end);
+
+/**
+ * \brief A unit of work executed by the \ref JobSystem
+ *
+ * Jobs are small values that are copied into the job deques, so submitting
+ * a job doesn't allocate. The context must outlive the job.
+ */
+struct Job {
+    /**
+     * \brief Function to execute
+     */
+    JobFunction function;
+
+    /**
+     * \brief Argument passed to the function
+     */
+    void *context;
+
+    /**
+     * \brief First index of the range to process
+     */
+    uint32_t begin;
+
+    /**
+     * \brief One past the last index of the range to process
+     */
+    uint32_t end;
+
+    /**
+     * \brief Group notified when the job completes
+     */
+    WaitGroup *group;
+};
+
+/**
+ * \brief Buffer pointer to a list (array) of jobs
+ */
+typedef buffptr<Job> JobList;
+
+}    // namespace djetk
+
+#endif    // JOB_H
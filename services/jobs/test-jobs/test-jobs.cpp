@@ -0,0 +1,194 @@
+/**
+    \file
+    \brief Job system tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <jobs/job-system.h>
+#include <testing/message-queue-stub.h>
+#include <testing/os-services-stub.h>
+#include <timing/freertos-ticks.h>
+
+using namespace djetk;
+
+/**
+    \brief Container class to construct a job system with two workers
+*/
+class TestJobSystemContainer {
+  public:
+    TestJobSystemContainer()
+        : job_list_a(jobs_a.data(), jobs_a.size()),
+        job_list_b(jobs_b.data(), jobs_b.size()),
+        deques{{JobDeque(job_list_a), JobDeque(job_list_b)}},
+        deque_list(deques.data(), deques.size()),
+        job_system(deque_list, wake_queue, done_queue, os_services)
+    {
+    }
+
+    /**
+     * \brief Capacity of each worker's deque
+     */
+    static constexpr size_t kDequeCapacity = 4;
+
+    /**
+     * \privatesection Test container injected stubs
+     */
+    std::array<Job, kDequeCapacity> jobs_a;
+    std::array<Job, kDequeCapacity> jobs_b;
+    JobList job_list_a;
+    JobList job_list_b;
+    std::array<JobDeque, 2> deques;
+    JobDequeList deque_list;
+    MessageQueueStub wake_queue;
+    MessageQueueStub done_queue;
+    OsServicesStub os_services;
+    JobSystem job_system;
+};
+
+/**
+ * \brief Number of indices processed by the tests
+ */
+static constexpr uint32_t kIndexCount = 20;
+
+/**
+ * \brief Job that counts how often each index was processed
+ */
+static void CountIndices(void *context, uint32_t begin, uint32_t end)
+{
+    auto counts = static_cast<std::array<uint32_t, kIndexCount> *>(context);
+    for (auto i = begin; i < end; i++) {
+        (*counts)[i]++;
+    }
+}
+
+/**
+ * \test Test that a parallel for processes every index exactly once
+ *
+ * No workers run, so the waiting task executes all the queued jobs itself
+ * and the jobs that didn't fit the deques are executed when submitted.
+ */
+void test_ParallelFor_NoWorkersRunning_WaiterProcessesEveryIndexOnce()
+{
+    TestJobSystemContainer container;
+    std::array<uint32_t, kIndexCount> counts{};
+
+    container.job_system.ParallelFor(kIndexCount, 2, CountIndices, &counts);
+
+    for (auto count : counts) {
+        TEST_ASSERT_EQUAL(1, count);
+    }
+
+    // 10 jobs for 8 deque slots
+    TEST_ASSERT_EQUAL(2, container.job_system.GetInlineCount());
+    TEST_ASSERT_EQUAL(0, container.deques[0].GetCount());
+    TEST_ASSERT_EQUAL(0, container.deques[1].GetCount());
+
+    // The waiter never had to block
+    TEST_ASSERT_EQUAL(0, container.done_queue.post_count);
+}
+
+/**
+ * \test Test that a worker with an empty deque steals the oldest job of another
+ */
+void test_RunJob_OwnDequeEmpty_StealsOldestJobFromOtherWorker()
+{
+    TestJobSystemContainer container;
+    std::array<uint32_t, kIndexCount> counts{};
+    WaitGroup group;
+
+    // Jobs are distributed in turn: 0 -> A, 1 -> B, 2 -> A
+    container.job_system.Submit(CountIndices, &counts, 0, 1, group);
+    container.job_system.Submit(CountIndices, &counts, 1, 2, group);
+    container.job_system.Submit(CountIndices, &counts, 2, 3, group);
+    TEST_ASSERT_EQUAL(3, container.wake_queue.post_count);
+
+    // Worker B runs its own job first
+    TEST_ASSERT_TRUE(container.job_system.RunJob(1));
+    TEST_ASSERT_EQUAL(1, counts[1]);
+    TEST_ASSERT_EQUAL(0, container.job_system.GetStealCount());
+
+    // Then steals from the top of A
+    TEST_ASSERT_TRUE(container.job_system.RunJob(1));
+    TEST_ASSERT_EQUAL(1, counts[0]);
+    TEST_ASSERT_EQUAL(0, counts[2]);
+    TEST_ASSERT_EQUAL(1, container.job_system.GetStealCount());
+    TEST_ASSERT_FALSE(group.IsDone());
+
+    // Worker A pops its remaining job and completes the group
+    TEST_ASSERT_TRUE(container.job_system.RunJob(0));
+    TEST_ASSERT_EQUAL(1, counts[2]);
+    TEST_ASSERT_TRUE(group.IsDone());
+    TEST_ASSERT_FALSE(container.job_system.RunJob(0));
+
+    // Nobody was waiting for the group
+    TEST_ASSERT_EQUAL(0, container.done_queue.post_count);
+}
+
+/**
+ * \test Test that an idle worker blocks on the wake queue until woken
+ */
+void test_RunWorker_NoJobs_BlocksOnWakeQueueWithoutTimeout()
+{
+    TestJobSystemContainer container;
+
+    container.job_system.RunWorker(0);
+
+    TEST_ASSERT_EQUAL(infinite_ms, container.wake_queue.receive_timeout_ms);
+}
+
+/**
+ * \test Test that the owner of a deque runs its most recently queued job first
+ */
+void test_PopBottom_SeveralJobs_ReturnsMostRecentJob()
+{
+    std::array<Job, 2> jobs;
+    JobList job_list(jobs.data(), jobs.size());
+    JobDeque deque(job_list);
+
+    Job first = { CountIndices, nullptr, 0, 1, nullptr };
+    Job second = { CountIndices, nullptr, 1, 2, nullptr };
+    TEST_ASSERT_TRUE(deque.PushBottom(first));
+    TEST_ASSERT_TRUE(deque.PushBottom(second));
+    TEST_ASSERT_FALSE(deque.PushBottom(second));
+
+    Job job;
+    TEST_ASSERT_TRUE(deque.PopBottom(job));
+    TEST_ASSERT_EQUAL(1, job.begin);
+    TEST_ASSERT_TRUE(deque.StealTop(job));
+    TEST_ASSERT_EQUAL(0, job.begin);
+    TEST_ASSERT_FALSE(deque.StealTop(job));
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_ParallelFor_NoWorkersRunning_WaiterProcessesEveryIndexOnce);
+    RUN_TEST(test_RunJob_OwnDequeEmpty_StealsOldestJobFromOtherWorker);
+    RUN_TEST(test_RunWorker_NoJobs_BlocksOnWakeQueueWithoutTimeout);
+    RUN_TEST(test_PopBottom_SeveralJobs_ReturnsMostRecentJob);
+    return UnityEnd();
+}
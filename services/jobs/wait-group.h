@@ -0,0 +1,72 @@
+/**
+    \file
+    \brief Job completion counter
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WAIT_GROUP_H
+#define WAIT_GROUP_H
+
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Tracks the completion of a set of jobs
+ *
+ * Every job submitted against a group increments its pending count, which
+ * is decremented when the job completes. \ref JobSystem::Wait returns once
+ * the count drops to zero. The group must outlive its jobs.
+ */
+class WaitGroup {
+  public:
+    WaitGroup()
+        : pending_(0),
+        waiting_(false)
+    {
+    }
+
+    /**
+     * \brief Check whether all the jobs of the group have completed
+     */
+    bool IsDone() const
+    {
+        return pending_ == 0;
+    }
+
+  private:
+    friend class JobSystem;
+
+    /**
+     * \brief Number of jobs that haven't completed yet. Updated with
+     *        interrupts disabled.
+     */
+    volatile uint32_t pending_;
+
+    /**
+     * \brief Set while a task is blocked waiting for the group. Updated with
+     *        interrupts disabled.
+     */
+    volatile bool waiting_;
+};
+
+}    // namespace djetk
+
+#endif    // WAIT_GROUP_H
@@ -0,0 +1,39 @@
+#include <messaging/cooperative-executor.h>
+
+namespace djetk {
+
+CooperativeExecutor::CooperativeExecutor(DispatcherList &dispatchers,
+        IIdleSleeper &sleeper, Policy policy)
+    : dispatchers_(dispatchers),
+    sleeper_(sleeper),
+    policy_(policy),
+    sleep_count_(0)
+{
+}
+
+bool CooperativeExecutor::RunOnce()
+{
+    bool dispatched = false;
+    for (auto dispatcher : dispatchers_) {
+        if (dispatcher->TryPoll()) {
+            dispatched = true;
+            if (policy_ == Policy::priority) {
+                break;
+            }
+        }
+    }
+
+    return dispatched;
+}
+
+void CooperativeExecutor::Run()
+{
+    for (;;) {
+        if (!RunOnce()) {
+            sleep_count_++;
+            sleeper_.Sleep();
+        }
+    }
+}
+
+}
@@ -0,0 +1,110 @@
+#ifndef COOPERATIVE_EXECUTOR_H
+#define COOPERATIVE_EXECUTOR_H
+
+#include <cstdint>
+#include <utilities/buffptr.h>
+#include "messaging/imessage-dispatcher.h"
+
+namespace djetk {
+
+/**
+ * \brief Interface used by a \ref CooperativeExecutor to wait for work
+ *
+ * Implementations may block the calling task until they are woken (see
+ * \ref FreeRTOSSemaphoreSleeper) or put the CPU to sleep until the next
+ * interrupt on bare metal targets. Queues posting to the executor's
+ * dispatchers wake it through \ref WakingQueue.
+ */
+class IIdleSleeper {
+  public:
+    /**
+     * \brief Block until new messages may have arrived
+     */
+    virtual void Sleep() = 0;
+
+    /**
+     * \brief End the current (or the next) \ref Sleep from thread context
+     */
+    virtual void Wake() = 0;
+
+    /**
+     * \brief End the current (or the next) \ref Sleep from ISR context
+     * \param[in,out] task_woken Set if a reschedule is required, otherwise
+     *                          left as is so it accumulates over the ISR
+     */
+    virtual void WakeFromIsr(bool &task_woken) = 0;
+
+    virtual ~IIdleSleeper() {}
+};
+
+/**
+ * \brief Buffer pointer to a list (array) of dispatchers
+ */
+typedef buffptr<IMessageDispatcher *> DispatcherList;
+
+/**
+ * \brief Runs many message dispatchers in a single thread of execution
+ *
+ * This is the "big loop": dispatchers are polled without blocking, so a
+ * single task (or bare metal main) serves all of them with one stack. The
+ * executor sleeps only when every dispatcher is idle.
+ *
+ * Handlers run to completion, so a long running handler delays all the
+ * other dispatchers of the executor.
+ */
+class CooperativeExecutor {
+  public:
+    /**
+     * \brief Order in which dispatchers are served
+     */
+    enum class Policy {
+        /**
+         * \brief Each dispatcher handles at most one message per pass
+         */
+        round_robin,
+
+        /**
+         * \brief Dispatchers earlier in the list are drained first. Every
+         *        handled message restarts the scan from the first dispatcher.
+         */
+        priority
+    };
+
+    /**
+     * \brief Construct the executor
+     * \param[in]   dispatchers     Dispatchers to serve (highest priority first)
+     * \param[in]   sleeper         Used to wait when all dispatchers are idle
+     * \param[in]   policy          Order in which dispatchers are served
+     */
+    CooperativeExecutor(DispatcherList &dispatchers, IIdleSleeper &sleeper,
+            Policy policy = Policy::round_robin);
+
+    /**
+     * \brief Serve the dispatchers once according to the policy
+     * \return false if no dispatcher had a message
+     */
+    bool RunOnce();
+
+    /**
+     * \brief Serve the dispatchers forever, sleeping when they're all idle
+     */
+    void Run();
+
+    /**
+     * \brief Get the number of times the executor went to sleep
+     */
+    uint32_t GetSleepCount() const
+    {
+        return sleep_count_;
+    }
+
+  private:
+    DispatcherList &dispatchers_;
+    IIdleSleeper &sleeper_;
+    Policy policy_;
+    uint32_t sleep_count_;
+};
+
+}  // namespace djetk
+
+#endif
@@ -0,0 +1,48 @@
+#include <messaging/coroutine.h>
+
+namespace djetk {
+
+Coroutine::Coroutine(ITickCounter &tick_counter)
+    : resume_point_(0),
+    blocked_(false),
+    tick_counter_(tick_counter),
+    timeout_start_(0),
+    timeout_ticks_(0)
+{
+}
+
+bool Coroutine::RegisterHandler(IMessageHandler &message_handler)
+{
+    (void)message_handler;
+    return false;
+}
+
+void Coroutine::Poll()
+{
+    TryPoll();
+}
+
+bool Coroutine::TryPoll()
+{
+    if (IsFinished()) {
+        return false;
+    }
+
+    blocked_ = false;
+    Run();
+    return !blocked_;
+}
+
+void Coroutine::StartTimeout(uint32_t ticks)
+{
+    timeout_start_ = tick_counter_.GetTickCount();
+    timeout_ticks_ = ticks;
+}
+
+bool Coroutine::IsTimedOut() const
+{
+    // Unsigned subtraction handles the counter wrapping around
+    return (tick_counter_.GetTickCount() - timeout_start_) >= timeout_ticks_;
+}
+
+}
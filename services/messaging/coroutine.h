@@ -0,0 +1,204 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include <cstdint>
+#include "messaging/imessage-dispatcher.h"
+#include "messaging/imessage-queue.h"
+#include "timing/itick-counter.h"
+
+/**
+ * \brief Start of a coroutine body. Must be the first statement of
+ *        \ref djetk::Coroutine::Run.
+ *
+ * Suspension points fall through into case labels by design, so the
+ * corresponding gcc warning is disabled for the body.
+ */
+#define DJETK_CO_BEGIN()                                            \
+    _Pragma("GCC diagnostic push")                                  \
+    _Pragma("GCC diagnostic ignored \"-Wpragmas\"")                 \
+    _Pragma("GCC diagnostic ignored \"-Wimplicit-fallthrough\"")    \
+    switch (resume_point_) { case 0:
+
+/**
+ * \brief End of a coroutine body. Must be the last statement of
+ *        \ref djetk::Coroutine::Run.
+ */
+#define DJETK_CO_END()                                              \
+    } resume_point_ = kFinished;                                    \
+    _Pragma("GCC diagnostic pop")                                   \
+    return
+
+/**
+ * \brief Return to the executor and resume at this point on the next poll
+ */
+#define DJETK_CO_YIELD()                        \
+    do {                                        \
+        resume_point_ = __LINE__;               \
+        return;                                 \
+        case __LINE__:;                         \
+    } while (0)
+
+/**
+ * \brief Suspend the coroutine until a condition holds
+ *
+ * The condition is evaluated on each poll of the coroutine.
+ */
+#define DJETK_CO_AWAIT(condition)               \
+    do {                                        \
+        resume_point_ = __LINE__;               \
+        case __LINE__:                          \
+        if (!(condition)) {                     \
+            blocked_ = true;                    \
+            return;                             \
+        }                                       \
+    } while (0)
+
+/**
+ * \brief Suspend the coroutine until a message is received from a queue
+ */
+#define DJETK_CO_AWAIT_MESSAGE(queue, msg)      \
+    DJETK_CO_AWAIT((queue).ReceiveMessage(0, (msg)))
+
+/**
+ * \brief Suspend the coroutine for a number of ticks
+ */
+#define DJETK_CO_AWAIT_DELAY(ticks)             \
+    do {                                        \
+        StartTimeout(ticks);                    \
+        DJETK_CO_AWAIT(IsTimedOut());           \
+    } while (0)
+
+/**
+ * \brief Suspend the coroutine until a message is received or a timeout
+ * \param queue     Queue to receive from
+ * \param msg       Message object to receive into
+ * \param ticks     Timeout in ticks
+ * \param received  bool variable set to true if a message was received
+ */
+#define DJETK_CO_AWAIT_MESSAGE_FOR(queue, msg, ticks, received)                 \
+    do {                                                                        \
+        StartTimeout(ticks);                                                    \
+        DJETK_CO_AWAIT(((received) = (queue).ReceiveMessage(0, (msg))) ||       \
+                IsTimedOut());                                                  \
+    } while (0)
+
+namespace djetk {
+
+/**
+ * \brief Stackless coroutine
+ *
+ * A coroutine is a state machine written as sequential code. The body
+ * (\ref Run) is enclosed by DJETK_CO_BEGIN() and DJETK_CO_END() and suspends
+ * with the DJETK_CO_AWAIT... and DJETK_CO_YIELD() macros. Resuming jumps
+ * back to the suspension point (a switch based protothread), so coroutines
+ * don't need a stack of their own. Any number of them can run on a single
+ * task through a \ref CooperativeExecutor.
+ *
+ * - Local variables don't survive a suspension. Keep state in members.
+ * - Only one suspension macro can be used per source line.
+ * - switch statements can't span a suspension point.
+ *
+ * \code
+ * class Blinker : public Coroutine {
+ *   ...
+ *     virtual void Run() override
+ *     {
+ *         DJETK_CO_BEGIN();
+ *         for (;;) {
+ *             DJETK_CO_AWAIT_MESSAGE_FOR(queue_, msg_, 500, received_);
+ *             led_.Toggle();
+ *         }
+ *         DJETK_CO_END();
+ *     }
+ * };
+ * \endcode
+ *
+ * FreeRTOS co-routines aren't used as their crSTART/crEND macros only work
+ * in a free function with a FreeRTOS managed handle, and they must be
+ * scheduled from the idle task.
+ */
+class Coroutine : public IMessageDispatcher {
+  public:
+    /**
+     * \brief Construct the coroutine
+     * \param[in]   tick_counter    Time base of timeouts and delays
+     */
+    explicit Coroutine(ITickCounter &tick_counter);
+
+    /**
+     * \brief Coroutines receive their own messages, so handlers can't be registered
+     * \return false
+     */
+    virtual bool RegisterHandler(IMessageHandler &message_handler) override;
+
+    /**
+     * \brief Resume the coroutine once
+     *
+     * Unlike other dispatchers, this doesn't block.
+     */
+    virtual void Poll() override;
+
+    /**
+     * \brief Resume the coroutine
+     * \return false if the coroutine is waiting (i.e. has nothing to do until
+     *         a message arrives or time passes) or has finished
+     */
+    virtual bool TryPoll() override;
+
+    /**
+     * \brief Check whether the body has run to its end
+     */
+    bool IsFinished() const
+    {
+        return resume_point_ == kFinished;
+    }
+
+    /**
+     * \brief Restart the body from the beginning
+     */
+    void Restart()
+    {
+        resume_point_ = 0;
+    }
+
+  protected:
+    /**
+     * \brief Resume point of a finished coroutine
+     */
+    static constexpr uint32_t kFinished = 0xffffffff;
+
+    /**
+     * \brief Coroutine body
+     */
+    virtual void Run() = 0;
+
+    /**
+     * \brief Start a timeout
+     * \param[in]   ticks   Timeout in ticks of the tick counter
+     */
+    void StartTimeout(uint32_t ticks);
+
+    /**
+     * \brief Check whether the timeout started last has elapsed
+     */
+    bool IsTimedOut() const;
+
+    /**
+     * \brief Line of the suspension point to resume at
+     */
+    uint32_t resume_point_;
+
+    /**
+     * \brief Set when the body suspends on an unmet condition
+     */
+    bool blocked_;
+
+  private:
+    ITickCounter &tick_counter_;
+    uint32_t timeout_start_;
+    uint32_t timeout_ticks_;
+};
+
+}  // namespace djetk
+
+#endif
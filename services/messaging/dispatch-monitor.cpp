@@ -0,0 +1,79 @@
+#include <messaging/dispatch-monitor.h>
+
+namespace djetk {
+
+DispatchMonitor::DispatchMonitor(ICycleCounter &cycle_counter, DispatchStatsList &stats_list,
+        ISlowHandlerCallback &callback)
+    : cycle_counter_(cycle_counter),
+    stats_list_(stats_list),
+    callback_(callback),
+    default_budget_(0),
+    untracked_(0)
+{
+}
+
+bool DispatchMonitor::SetBudget(uint32_t id, uint32_t cycles)
+{
+    auto entry = Find(id, true);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    entry->stats.SetBudget(cycles);
+    return true;
+}
+
+const ExecutionStats *DispatchMonitor::GetStats(uint32_t id) const
+{
+    auto entry = const_cast<DispatchMonitor *>(this)->Find(id, false);
+    return (entry != nullptr) ? &entry->stats : nullptr;
+}
+
+void DispatchMonitor::End(const Message &msg, uint32_t begin)
+{
+    auto cycles = cycle_counter_.GetCycles() - begin;
+
+    auto entry = Find(msg.id, true);
+    if (entry == nullptr) {
+        untracked_++;
+        return;
+    }
+
+    if (!entry->stats.Record(cycles)) {
+        callback_.OnSlowHandler(msg, cycles);
+    }
+}
+
+DispatchStats *DispatchMonitor::Find(uint32_t id, bool assign)
+{
+    auto size = stats_list_.size();
+    if (size == 0) {
+        return nullptr;
+    }
+
+    // Linear probing from the hashed slot
+    auto slot = id % size;
+    for (size_t probe = 0; probe < size; probe++) {
+        auto &entry = stats_list_.data()[slot];
+        if (!entry.in_use) {
+            if (!assign) {
+                return nullptr;
+            }
+
+            entry.id = id;
+            entry.in_use = true;
+            entry.stats.SetBudget(default_budget_);
+            return &entry;
+        }
+
+        if (entry.id == id) {
+            return &entry;
+        }
+
+        slot = (slot + 1 < size) ? slot + 1 : 0;
+    }
+
+    return nullptr;
+}
+
+}
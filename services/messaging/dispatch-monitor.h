@@ -0,0 +1,153 @@
+#ifndef DISPATCH_MONITOR_H
+#define DISPATCH_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "messaging/message.h"
+#include "profiling/icycle-counter.h"
+#include "profiling/execution-stats.h"
+#include "utilities/buffptr.h"
+
+namespace djetk {
+
+/**
+ * \brief Callback interface to be notified of handlers that overran their budget
+ */
+class ISlowHandlerCallback {
+  public:
+    /**
+     * \brief Notify that handling a message took longer than its budget
+     * \param[in]   msg     The message that was handled
+     * \param[in]   cycles  Time taken to handle the message
+     *
+     * Invoked from the dispatching task right after the handler returns.
+     */
+    virtual void OnSlowHandler(const Message &msg, uint32_t cycles) = 0;
+
+    virtual ~ISlowHandlerCallback() {}
+};
+
+/**
+ * \brief Handling time statistics of one message ID
+ */
+struct DispatchStats {
+    DispatchStats()
+        : id(0),
+        in_use(false) {}
+
+    /**
+     * \brief Message ID the statistics belong to
+     */
+    uint32_t id;
+
+    /**
+     * \brief Set once the entry is assigned to a message ID
+     */
+    bool in_use;
+
+    /**
+     * \brief Handling times of the messages with this ID. The budget of these
+     *        statistics triggers the slow handler callback.
+     */
+    ExecutionStats stats;
+};
+
+/**
+ * \brief Buffer pointer to a list (array) of dispatch statistics
+ */
+typedef buffptr<DispatchStats> DispatchStatsList;
+
+/**
+ * \brief Records how long the handler of a dispatcher takes per message ID
+ *
+ * Attach to a dispatcher with \ref QueueDispatcher::EnableMonitoring. Each
+ * dispatch is timed and recorded against the ID of the message, so the
+ * maximum and p99 (see \ref ExecutionStats::GetPercentile) point at the
+ * message types that hold up the queue.
+ *
+ * - The statistics live in an injected list, which is used as a hash table
+ *   keyed by message ID. IDs that don't fit the list (all of them if the
+ *   list is empty) are counted as untracked.
+ * - The p99 is known to within 25%, so it can be compared against the
+ *   budgets to spot message types that get close to overrunning.
+ * - A handler taking longer than the budget of its message ID is reported
+ *   to the slow handler callback
+ */
+class DispatchMonitor {
+  public:
+    /**
+     * \brief Construct a monitor
+     * \param[in]   cycle_counter   Clock to measure the handling time with
+     * \param[in]   stats_list      Storage for the per message ID statistics
+     * \param[in]   callback        Callback to notify of slow handlers
+     */
+    DispatchMonitor(ICycleCounter &cycle_counter, DispatchStatsList &stats_list,
+            ISlowHandlerCallback &callback);
+
+    /**
+     * \brief Set the budget of the message IDs seen for the first time
+     * \param[in]   cycles  Budget in cycles. 0 disables the budget.
+     */
+    void SetDefaultBudget(uint32_t cycles)
+    {
+        default_budget_ = cycles;
+    }
+
+    /**
+     * \brief Set the budget of a message ID
+     * \param[in]   id      Message ID
+     * \param[in]   cycles  Budget in cycles. 0 disables the budget.
+     * \return false if there's no room to track the message ID
+     */
+    bool SetBudget(uint32_t id, uint32_t cycles);
+
+    /**
+     * \brief Get the statistics of a message ID
+     * \param[in]   id  Message ID
+     * \return nullptr if no message with the ID was handled
+     */
+    const ExecutionStats *GetStats(uint32_t id) const;
+
+    /**
+     * \brief Get the number of dispatches of message IDs that didn't fit the list
+     */
+    uint32_t GetUntrackedCount() const
+    {
+        return untracked_;
+    }
+
+    /**
+     * \brief Read the clock before dispatching a message
+     */
+    uint32_t Begin()
+    {
+        return cycle_counter_.GetCycles();
+    }
+
+    /**
+     * \brief Record the time taken to dispatch a message
+     * \param[in]   msg     The dispatched message
+     * \param[in]   begin   Value returned by \ref Begin
+     */
+    void End(const Message &msg, uint32_t begin);
+
+  private:
+    DispatchMonitor(const DispatchMonitor &rhs);
+    const DispatchMonitor& operator=(const DispatchMonitor &rhs);
+
+    /**
+     * \brief Find the entry of a message ID, optionally assigning a free one
+     * \return nullptr if not found and not assigned
+     */
+    DispatchStats *Find(uint32_t id, bool assign);
+
+    ICycleCounter &cycle_counter_;
+    DispatchStatsList &stats_list_;
+    ISlowHandlerCallback &callback_;
+    uint32_t default_budget_;
+    uint32_t untracked_;
+};
+
+}  // namespace djetk
+
+#endif
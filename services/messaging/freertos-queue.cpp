@@ -21,8 +21,12 @@ FreeRTOSQueue::~FreeRTOSQueue()
 
 bool FreeRTOSQueue::PostMessage(const Message &message, uint32_t timeout_ms)
 {
-    auto timeout = ms_to_FreeRTOSTicks(timeout_ms);
-    if (xQueueSend( message_queue_, &message, timeout ) != pdPASS ) {
+    return PostMessage(message, Ticks(ms_to_FreeRTOSTicks(timeout_ms)));
+}
+
+bool FreeRTOSQueue::PostMessage(const Message &message, Ticks timeout)
+{
+    if (xQueueSend( message_queue_, &message, timeout.Count() ) != pdPASS ) {
         return false;
     }
 
@@ -31,20 +35,27 @@ bool FreeRTOSQueue::PostMessage(const Message &message, uint32_t timeout_ms)
 
 bool FreeRTOSQueue::PostMessageFromIsr(const Message &message, bool &task_woken)
 {
-    // TODO Need a test case for this function
-    portBASE_TYPE xHigherPriorityTaskWoken;
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
     if (xQueueSendFromISR(message_queue_, &message, &xHigherPriorityTaskWoken) == pdFALSE) {
         return false;
     }
 
-    task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    // Other calls within the same ISR may have already woken a task
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        task_woken = true;
+    }
+
     return true;
 }
 
 bool FreeRTOSQueue::ReceiveMessage(uint32_t timeout_ms, Message &message)
 {
-    auto timeout = ms_to_FreeRTOSTicks(timeout_ms);
-    if (xQueueReceive(message_queue_, &message, timeout) != pdPASS ) {
+    return ReceiveMessage(Ticks(ms_to_FreeRTOSTicks(timeout_ms)), message);
+}
+
+bool FreeRTOSQueue::ReceiveMessage(Ticks timeout, Message &message)
+{
+    if (xQueueReceive(message_queue_, &message, timeout.Count()) != pdPASS ) {
         return false;
     }
 
@@ -53,13 +64,16 @@ bool FreeRTOSQueue::ReceiveMessage(uint32_t timeout_ms, Message &message)
 
 bool FreeRTOSQueue::ReceiveMessageFromIsr(Message &message, bool &task_woken)
 {
-    // TODO Need a test case for this function
-    portBASE_TYPE xHigherPriorityTaskWoken;
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
     if (xQueueReceiveFromISR(message_queue_, &message, &xHigherPriorityTaskWoken) == pdFALSE) {
         return false;
     }
 
-    task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    // Other calls within the same ISR may have already woken a task
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        task_woken = true;
+    }
+
     return true;
 }
 
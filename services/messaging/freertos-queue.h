@@ -4,6 +4,7 @@
 #include <FreeRTOS/Source/include/FreeRTOS.h>
 #include <FreeRTOS/Source/include/queue.h>
 #include "messaging/imessage-queue.h"
+#include "timing/freertos-duration.h"
 #include "errors/icritical-error-handler.h"
 
 namespace djetk {
@@ -34,6 +35,26 @@ class FreeRTOSQueue : public IMessageQueue {
     virtual bool ReceiveMessage(uint32_t timeout_ms, Message &message) override;
     virtual bool ReceiveMessageFromIsr(Message &message, bool &task_woken) override;
 
+    /**
+     * \brief Post a message into the queue from thread context
+     * \param[in] message       Reference to the message object
+     * \param[in] timeout       Timeout if the message queue is full (e.g. 10_ms
+     *                          or Ticks::Infinite())
+     * \retval true Message successfully queued
+     * \retval false Timed out
+     */
+    bool PostMessage(const Message &message, Ticks timeout);
+
+    /**
+     * \brief Receive a message from the queue from thread context
+     * \param[in]  timeout      Timeout if the message queue is empty (e.g. 10_ms
+     *                          or Ticks::Infinite())
+     * \param[out] message      Reference to the message object write location
+     * \retval true Message successfully retrieved
+     * \retval false Timed out
+     */
+    bool ReceiveMessage(Ticks timeout, Message &message);
+
   private:
     FreeRTOSQueue(const FreeRTOSQueue &rhs);
     const FreeRTOSQueue& operator=(const FreeRTOSQueue &rhs);
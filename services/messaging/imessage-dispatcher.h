@@ -39,6 +39,12 @@ class IMessageDispatcher {
      * \brief Poll the message source (e.g. a queue) for messages
      */
     virtual void Poll() = 0;
+
+    /**
+     * \brief Dispatch a pending message without blocking
+     * \return true if a message was dispatched
+     */
+    virtual bool TryPoll() = 0;
 };
 
 }  // namespace djetk
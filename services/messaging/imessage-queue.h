@@ -23,7 +23,8 @@ class IMessageQueue {
     /**
      * \brief Post a message into the queue from ISR context
      * \param[in] message       Reference to the message object
-     * \param[out]  task_woken  Indicates if a reschedule is required
+     * \param[in,out] task_woken Set if a reschedule is required, otherwise
+     *                          left as is so it accumulates over the ISR
      * \retval true Message successfully queued
      * \retval false Failed to post the message (queue full)
      */
@@ -41,7 +42,8 @@ class IMessageQueue {
     /**
      * \brief Receive a message from the queue from ISR context
      * \param[out] message      Reference to the message object write location
-     * \param[out] task_woken   Indicates if a reschedule is required
+     * \param[in,out] task_woken Set if a reschedule is required, otherwise
+     *                          left as is so it accumulates over the ISR
      * \retval true Message successfully retrieved
      * \retval false Queue empty
      */
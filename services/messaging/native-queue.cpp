@@ -0,0 +1,161 @@
+#include <cerrno>
+#include <ctime>
+#include <limits>
+#include "messaging/native-queue.h"
+
+namespace djetk {
+
+namespace {
+
+/**
+ * \brief Timeout that waits forever, as infinite_ms
+ */
+constexpr uint32_t kWaitForever = std::numeric_limits<uint32_t>::max();
+
+/**
+ * \brief Cancellation clean up handler that releases a mutex
+ */
+void UnlockMutex(void *mutex)
+{
+    pthread_mutex_unlock(static_cast<pthread_mutex_t *>(mutex));
+}
+
+}   // namespace
+
+NativeQueue::NativeQueue(size_t queue_length)
+    : messages_(new Message[queue_length]),
+    length_(queue_length),
+    head_(0),
+    count_(0),
+    senders_waiting_(0),
+    receivers_waiting_(0)
+{
+    pthread_mutex_init(&mutex_, nullptr);
+
+    // Time outs are measured on the monotonic clock
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&not_full_, &attr);
+    pthread_cond_init(&not_empty_, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+NativeQueue::~NativeQueue()
+{
+    pthread_cond_destroy(&not_empty_);
+    pthread_cond_destroy(&not_full_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+bool NativeQueue::PostMessage(const Message &message, uint32_t timeout_ms)
+{
+    bool posted = false;
+    pthread_mutex_lock(&mutex_);
+    pthread_cleanup_push(UnlockMutex, &mutex_);
+    if (WaitFor(not_full_, timeout_ms, &NativeQueue::HasRoom, senders_waiting_)) {
+        Push(message);
+        posted = true;
+    }
+    pthread_cleanup_pop(1);
+
+    return posted;
+}
+
+bool NativeQueue::PostMessageFromIsr(const Message &message, bool &task_woken)
+{
+    pthread_mutex_lock(&mutex_);
+    auto posted = HasRoom();
+    if (posted && Push(message)) {
+        task_woken = true;
+    }
+    pthread_mutex_unlock(&mutex_);
+
+    return posted;
+}
+
+bool NativeQueue::ReceiveMessage(uint32_t timeout_ms, Message &message)
+{
+    bool received = false;
+    pthread_mutex_lock(&mutex_);
+    pthread_cleanup_push(UnlockMutex, &mutex_);
+    if (WaitFor(not_empty_, timeout_ms, &NativeQueue::HasMessage, receivers_waiting_)) {
+        Pop(message);
+        received = true;
+    }
+    pthread_cleanup_pop(1);
+
+    return received;
+}
+
+bool NativeQueue::ReceiveMessageFromIsr(Message &message, bool &task_woken)
+{
+    pthread_mutex_lock(&mutex_);
+    auto received = HasMessage();
+    if (received && Pop(message)) {
+        task_woken = true;
+    }
+    pthread_mutex_unlock(&mutex_);
+
+    return received;
+}
+
+bool NativeQueue::WaitFor(pthread_cond_t &cond, uint32_t timeout_ms,
+        bool (NativeQueue::*ready)() const, uint32_t &waiters)
+{
+    timespec deadline;
+    if ((timeout_ms != 0) && (timeout_ms != kWaitForever)) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += static_cast<long>(timeout_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    while (!(this->*ready)()) {
+        if (timeout_ms == 0) {
+            return false;
+        }
+
+        // The count is left raised if the waiter is cancelled, which only
+        // costs spurious signals
+        waiters++;
+        auto rv = (timeout_ms == kWaitForever) ? pthread_cond_wait(&cond, &mutex_) :
+            pthread_cond_timedwait(&cond, &mutex_, &deadline);
+        waiters--;
+        if (rv == ETIMEDOUT) {
+            return (this->*ready)();
+        }
+    }
+
+    return true;
+}
+
+bool NativeQueue::Push(const Message &message)
+{
+    messages_[(head_ + count_) % length_] = message;
+    count_++;
+    if (receivers_waiting_ == 0) {
+        return false;
+    }
+
+    pthread_cond_signal(&not_empty_);
+    return true;
+}
+
+bool NativeQueue::Pop(Message &message)
+{
+    message = messages_[head_];
+    head_ = (head_ + 1) % length_;
+    count_--;
+    if (senders_waiting_ == 0) {
+        return false;
+    }
+
+    pthread_cond_signal(&not_full_);
+    return true;
+}
+
+}   // namespace djetk
@@ -0,0 +1,84 @@
+#ifndef NATIVE_QUEUE_H
+#define NATIVE_QUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <pthread.h>
+#include "messaging/imessage-queue.h"
+
+namespace djetk {
+
+/**
+ * \brief Message queue between native POSIX threads
+ *
+ * The host counterpart of \ref FreeRTOSQueue, for tasks that run as native
+ * threads (see \ref NativeTaskBase).
+ *
+ * - A timeout of infinite_ms (all bits set) waits forever
+ * - There are no interrupts on the host. The FromIsr methods don't block,
+ *   and set task_woken when they release a waiting thread.
+ * - Blocked threads may be cancelled (see \ref NativeTaskBase::Stop)
+ */
+class NativeQueue : public IMessageQueue {
+  public:
+    /**
+     * \brief Construct a queue
+     * \param[in] queue_length  Number of \ref Message objects held by the queue
+     */
+    explicit NativeQueue(size_t queue_length);
+    ~NativeQueue();
+
+    virtual bool PostMessage(const Message &message, uint32_t timeout_ms) override;
+    virtual bool PostMessageFromIsr(const Message &message, bool &task_woken) override;
+    virtual bool ReceiveMessage(uint32_t timeout_ms, Message &message) override;
+    virtual bool ReceiveMessageFromIsr(Message &message, bool &task_woken) override;
+
+  private:
+    NativeQueue(const NativeQueue &rhs);
+    const NativeQueue& operator=(const NativeQueue &rhs);
+
+    /**
+     * \brief Wait on a condition until it holds or the timeout expires
+     * \return true if the condition holds
+     *
+     * Must be invoked with the mutex locked.
+     */
+    bool WaitFor(pthread_cond_t &cond, uint32_t timeout_ms, bool (NativeQueue::*ready)() const,
+            uint32_t &waiters);
+
+    bool HasRoom() const
+    {
+        return count_ < length_;
+    }
+
+    bool HasMessage() const
+    {
+        return count_ != 0;
+    }
+
+    /**
+     * \brief Append a message. Must be invoked with the mutex locked and room.
+     * \return true if a receiver was waiting
+     */
+    bool Push(const Message &message);
+
+    /**
+     * \brief Remove the oldest message. Must be invoked with the mutex locked.
+     * \return true if a sender was waiting
+     */
+    bool Pop(Message &message);
+
+    std::unique_ptr<Message[]> messages_;
+    size_t length_;
+    size_t head_;
+    size_t count_;
+    uint32_t senders_waiting_;
+    uint32_t receivers_waiting_;
+    pthread_mutex_t mutex_;
+    pthread_cond_t not_full_;
+    pthread_cond_t not_empty_;
+};
+
+}   // namespace djetk
+
+#endif
@@ -5,7 +5,8 @@ namespace djetk {
 
 QueueDispatcher::QueueDispatcher(IMessageQueue &message_queue)
     : message_queue_(message_queue),
-    message_handler_(nullptr)
+    message_handler_(nullptr),
+    monitor_(nullptr)
 {
 }
 
@@ -31,10 +32,37 @@ void QueueDispatcher::Poll()
     Message msg;
     // TODO timeout
     if (message_queue_.ReceiveMessage(infinite_ms, msg)) {
-        message_handler_->HandleMessage(msg);
+        Dispatch(msg);
         // TODO check return code
     }
 }
 
+bool QueueDispatcher::TryPoll()
+{
+    if (message_handler_ == nullptr) {
+        return false;
+    }
+
+    Message msg;
+    if (!message_queue_.ReceiveMessage(0, msg)) {
+        return false;
+    }
+
+    Dispatch(msg);
+    return true;
+}
+
+void QueueDispatcher::Dispatch(const Message &msg)
+{
+    if (monitor_ == nullptr) {
+        message_handler_->HandleMessage(msg);
+        return;
+    }
+
+    auto begin = monitor_->Begin();
+    message_handler_->HandleMessage(msg);
+    monitor_->End(msg, begin);
+}
+
 }
 
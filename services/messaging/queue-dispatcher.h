@@ -4,6 +4,7 @@
 #include <cstddef>
 #include "messaging/imessage-dispatcher.h"
 #include "messaging/imessage-queue.h"
+#include "messaging/dispatch-monitor.h"
 
 namespace djetk {
 
@@ -31,7 +32,36 @@ class QueueDispatcher : public IMessageDispatcher {
      */
     virtual void Poll() override;
 
+    /**
+     * \brief See \ref IMessageDispatcher::TryPoll
+     */
+    virtual bool TryPoll() override;
+
+    /**
+     * \brief Time each dispatch and record it per message ID
+     * \param[in]   monitor     Monitor to record the handling times in
+     *
+     * Without a monitor, dispatching costs a single extra check.
+     */
+    void EnableMonitoring(DispatchMonitor &monitor)
+    {
+        monitor_ = &monitor;
+    }
+
+    /**
+     * \brief Stop timing the dispatches
+     */
+    void DisableMonitoring()
+    {
+        monitor_ = nullptr;
+    }
+
   private:
+    /**
+     * \brief Pass a received message to the handler
+     */
+    void Dispatch(const Message &msg);
+
     /**
      * \brief The message queue that the dispatcher will block on
      */
@@ -41,6 +71,11 @@ class QueueDispatcher : public IMessageDispatcher {
      * \brief Reference to registered message handler.
      */
     IMessageHandler *message_handler_;
+
+    /**
+     * \brief Monitor of the handling times, if enabled
+     */
+    DispatchMonitor *monitor_;
 };
 
 }  // namespace djetk
@@ -74,6 +74,45 @@ void test_ReceiveMessage_EmptyQueue_ReturnsFailure()
     TEST_ASSERT_FALSE(queue.ReceiveMessage(0, result));
 }
 
+/**
+ * \brief Test that posting from an ISR keeps a task_woken set by an earlier call
+ */
+void test_PostMessageFromIsr_NoTaskWoken_KeepsEarlierTaskWoken()
+{
+    CriticalErrorHandlerStub error_handler;
+    static constexpr size_t kQueueSize = 2;
+    FreeRTOSQueue queue(kQueueSize, error_handler);
+
+    // No task waits on the queue, so the posts don't wake anything
+    Message message(0, nullptr);
+    bool task_woken = false;
+    TEST_ASSERT_TRUE(queue.PostMessageFromIsr(message, task_woken));
+    TEST_ASSERT_FALSE(task_woken);
+
+    task_woken = true;
+    TEST_ASSERT_TRUE(queue.PostMessageFromIsr(message, task_woken));
+    TEST_ASSERT_TRUE(task_woken);
+}
+
+/**
+ * \brief Test that receiving from an ISR keeps a task_woken set by an earlier call
+ */
+void test_ReceiveMessageFromIsr_NoTaskWoken_KeepsEarlierTaskWoken()
+{
+    CriticalErrorHandlerStub error_handler;
+    static constexpr size_t kQueueSize = 1;
+    FreeRTOSQueue queue(kQueueSize, error_handler);
+
+    Message message(7, nullptr);
+    queue.PostMessage(message, 0);
+
+    Message result;
+    bool task_woken = true;
+    TEST_ASSERT_TRUE(queue.ReceiveMessageFromIsr(result, task_woken));
+    TEST_ASSERT_EQUAL(message.id, result.id);
+    TEST_ASSERT_TRUE(task_woken);
+}
+
 /**
  * \brief FreeRTOS task to run the tests from within
  *  The task invokes all the test cases define above before stopping the
@@ -102,6 +141,8 @@ class TestRunnerTask : public FreeRTOSTaskBase {
         RUN_TEST(test_PostMessage_FullQueue_FailsWithTimeout);
         RUN_TEST(test_ReceiveMessage_NonEmptyQueue_SuccessfullyRetrievesMessage);
         RUN_TEST(test_ReceiveMessage_EmptyQueue_ReturnsFailure);
+        RUN_TEST(test_PostMessageFromIsr_NoTaskWoken_KeepsEarlierTaskWoken);
+        RUN_TEST(test_ReceiveMessageFromIsr_NoTaskWoken_KeepsEarlierTaskWoken);
         // TODO Add test cases to check the timeout is as expected
 
         scheduler_.Stop();
@@ -3,8 +3,13 @@ extern "C"
 #include <unity.h>
 }
 
+#include <array>
 #include <messaging/queue-dispatcher.h>
+#include <messaging/cooperative-executor.h>
+#include <messaging/coroutine.h>
+#include <messaging/waking-queue.h>
 #include <testing/message-queue-stub.h>
+#include <testing/cycle-counter-stub.h>
 
 using namespace djetk;
 
@@ -25,6 +30,27 @@ class MessageHandlerStub : public IMessageHandler {
     Message msg_in;
 };
 
+/**
+ * \brief Slow handler callback stub
+ */
+class SlowHandlerCallbackStub : public ISlowHandlerCallback {
+  public:
+    SlowHandlerCallbackStub()
+        : slow_count(0),
+        last_cycles(0) {}
+
+    virtual void OnSlowHandler(const Message &msg, uint32_t cycles) override
+    {
+        slow_count++;
+        last_msg = msg;
+        last_cycles = cycles;
+    }
+
+    uint32_t slow_count;
+    Message last_msg;
+    uint32_t last_cycles;
+};
+
 /**
  * \test Test that a \ref QueueDispatcher, when polled, reads from the injected
  *     message queue and notifies the registered message handler of the retrieved
@@ -53,10 +79,365 @@ void test_Poll_PushesMessageFromQueueToHandler()
     TEST_ASSERT_EQUAL(handler.msg_in.payload.pdata, queue.msg_out.payload.pdata);
 }
 
+/**
+ * \test Test that \ref QueueDispatcher::TryPoll reports whether a message was
+ *     dispatched
+ */
+void test_TryPoll_EmptyQueue_ReturnsFalseWithoutDispatching()
+{
+    MessageQueueStub queue;
+    QueueDispatcher dispatcher(queue);
+    MessageHandlerStub handler;
+    dispatcher.RegisterHandler(handler);
+
+    queue.msg_out.id = 12345;
+    queue.is_empty = true;
+    TEST_ASSERT_FALSE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(0, handler.msg_in.id);
+
+    queue.is_empty = false;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(12345, handler.msg_in.id);
+}
+
+/**
+ * \test Test that a monitored dispatcher records handling times per message ID
+ *     and reports handlers that overrun their budget
+ */
+void test_TryPoll_MonitoringEnabled_RecordsPerIdAndReportsSlowHandler()
+{
+    MessageQueueStub queue;
+    QueueDispatcher dispatcher(queue);
+    MessageHandlerStub handler;
+    dispatcher.RegisterHandler(handler);
+
+    CycleCounterStub cycle_counter;
+    std::array<DispatchStats, 2> storage;
+    DispatchStatsList stats_list(storage.data(), storage.size());
+    SlowHandlerCallbackStub callback;
+    DispatchMonitor monitor(cycle_counter, stats_list, callback);
+    monitor.SetDefaultBudget(100);
+    TEST_ASSERT_TRUE(monitor.SetBudget(7, 20));
+    dispatcher.EnableMonitoring(monitor);
+
+    queue.msg_out.id = 5;
+    cycle_counter.step = 30;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    cycle_counter.step = 60;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(0, callback.slow_count);
+
+    // The budget of ID 7 is tighter
+    queue.msg_out.id = 7;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(1, callback.slow_count);
+    TEST_ASSERT_EQUAL(7, callback.last_msg.id);
+    TEST_ASSERT_EQUAL(60, callback.last_cycles);
+
+    auto stats = monitor.GetStats(5);
+    TEST_ASSERT_NOT_NULL(stats);
+    TEST_ASSERT_EQUAL(2, stats->GetCount());
+    TEST_ASSERT_EQUAL(60, stats->GetMax());
+    TEST_ASSERT_EQUAL(60, stats->GetPercentile(99));
+    TEST_ASSERT_NULL(monitor.GetStats(9));
+
+    // No room left for a third ID
+    queue.msg_out.id = 9;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(1, monitor.GetUntrackedCount());
+
+    // Handling is no longer timed once disabled
+    dispatcher.DisableMonitoring();
+    queue.msg_out.id = 5;
+    TEST_ASSERT_TRUE(dispatcher.TryPoll());
+    TEST_ASSERT_EQUAL(2, stats->GetCount());
+}
+
+/**
+ * \test Test that a monitor without storage counts every message as untracked
+ */
+void test_End_EmptyStatsList_CountsUntracked()
+{
+    CycleCounterStub cycle_counter;
+    DispatchStatsList stats_list(nullptr, 0);
+    SlowHandlerCallbackStub callback;
+    DispatchMonitor monitor(cycle_counter, stats_list, callback);
+
+    TEST_ASSERT_FALSE(monitor.SetBudget(7, 20));
+    monitor.End(Message(7, static_cast<size_t>(0)), monitor.Begin());
+    TEST_ASSERT_EQUAL(1, monitor.GetUntrackedCount());
+    TEST_ASSERT_NULL(monitor.GetStats(7));
+    TEST_ASSERT_EQUAL(0, callback.slow_count);
+}
+
+/**
+ * \brief Dispatcher stub with a number of pending messages
+ */
+class MessageDispatcherStub : public IMessageDispatcher {
+  public:
+    MessageDispatcherStub()
+        : pending(0),
+        dispatched(0)
+    {
+    }
+
+    virtual bool RegisterHandler(IMessageHandler &message_handler) override
+    {
+        (void)message_handler;
+        return true;
+    }
+
+    virtual void Poll() override
+    {
+    }
+
+    virtual bool TryPoll() override
+    {
+        if (pending == 0) {
+            return false;
+        }
+
+        pending--;
+        dispatched++;
+        return true;
+    }
+
+    /**
+     * \brief Number of messages left to dispatch
+     */
+    int pending;
+
+    /**
+     * \brief Number of messages dispatched
+     */
+    int dispatched;
+};
+
+/**
+ * \brief Sleeper stub
+ */
+class IdleSleeperStub : public IIdleSleeper {
+  public:
+    IdleSleeperStub()
+        : wake_count(0)
+    {
+    }
+
+    virtual void Sleep() override
+    {
+    }
+
+    virtual void Wake() override
+    {
+        wake_count++;
+    }
+
+    virtual void WakeFromIsr(bool &task_woken) override
+    {
+        wake_count++;
+        task_woken = true;
+    }
+
+    /**
+     * \brief Number of wake ups
+     */
+    int wake_count;
+};
+
+/**
+ * \test Test that a round robin executor serves each dispatcher once per pass
+ */
+void test_RunOnce_RoundRobin_EachDispatcherServedOncePerPass()
+{
+    std::array<MessageDispatcherStub, 2> stubs;
+    std::array<IMessageDispatcher *, 2> dispatchers{{&stubs[0], &stubs[1]}};
+    DispatcherList dispatcher_list(dispatchers.data(), dispatchers.size());
+    IdleSleeperStub sleeper;
+    CooperativeExecutor executor(dispatcher_list, sleeper);
+
+    stubs[0].pending = 2;
+    stubs[1].pending = 1;
+
+    TEST_ASSERT_TRUE(executor.RunOnce());
+    TEST_ASSERT_EQUAL(1, stubs[0].dispatched);
+    TEST_ASSERT_EQUAL(1, stubs[1].dispatched);
+    TEST_ASSERT_TRUE(executor.RunOnce());
+    TEST_ASSERT_EQUAL(2, stubs[0].dispatched);
+    TEST_ASSERT_FALSE(executor.RunOnce());
+}
+
+/**
+ * \test Test that a priority executor drains the first dispatcher first
+ */
+void test_RunOnce_Priority_HigherPriorityDispatcherDrainedFirst()
+{
+    std::array<MessageDispatcherStub, 2> stubs;
+    std::array<IMessageDispatcher *, 2> dispatchers{{&stubs[0], &stubs[1]}};
+    DispatcherList dispatcher_list(dispatchers.data(), dispatchers.size());
+    IdleSleeperStub sleeper;
+    CooperativeExecutor executor(dispatcher_list, sleeper,
+            CooperativeExecutor::Policy::priority);
+
+    stubs[0].pending = 2;
+    stubs[1].pending = 1;
+
+    TEST_ASSERT_TRUE(executor.RunOnce());
+    TEST_ASSERT_TRUE(executor.RunOnce());
+    TEST_ASSERT_EQUAL(2, stubs[0].dispatched);
+    TEST_ASSERT_EQUAL(0, stubs[1].dispatched);
+    TEST_ASSERT_TRUE(executor.RunOnce());
+    TEST_ASSERT_EQUAL(1, stubs[1].dispatched);
+    TEST_ASSERT_FALSE(executor.RunOnce());
+}
+
+/**
+ * \test Test that messages posted through a waking queue wake the executor
+ */
+void test_WakingQueue_MessagePosted_WakesSleeper()
+{
+    MessageQueueStub queue;
+    IdleSleeperStub sleeper;
+    WakingQueue waking_queue(queue, sleeper);
+
+    TEST_ASSERT_TRUE(waking_queue.PostMessage(Message(3, static_cast<size_t>(0)), 0));
+    TEST_ASSERT_EQUAL(1, sleeper.wake_count);
+    TEST_ASSERT_EQUAL(3, queue.posted_msg.id);
+
+    bool task_woken = false;
+    TEST_ASSERT_TRUE(waking_queue.PostMessageFromIsr(Message(4, static_cast<size_t>(0)),
+                task_woken));
+    TEST_ASSERT_EQUAL(2, sleeper.wake_count);
+    TEST_ASSERT_TRUE(task_woken);
+
+    // Receiving doesn't wake anything
+    Message msg;
+    queue.msg_out.id = 5;
+    TEST_ASSERT_TRUE(waking_queue.ReceiveMessage(0, msg));
+    TEST_ASSERT_EQUAL(5, msg.id);
+    TEST_ASSERT_EQUAL(2, sleeper.wake_count);
+}
+
+/**
+ * \brief Tick counter stub
+ */
+class TickCounterStub : public ITickCounter {
+  public:
+    TickCounterStub()
+        : ticks(0)
+    {
+    }
+
+    virtual uint32_t GetTickCount() const override
+    {
+        return ticks;
+    }
+
+    /**
+     * \brief Current tick count
+     */
+    uint32_t ticks;
+};
+
+/**
+ * \brief Coroutine that counts received messages and timeouts
+ */
+class CoroutineStub : public Coroutine {
+  public:
+    /**
+     * \brief Constructor
+     * \param[in]   tick_counter    Time base
+     * \param[in]   queue           Queue to receive messages from
+     */
+    CoroutineStub(ITickCounter &tick_counter, IMessageQueue &queue)
+        : Coroutine(tick_counter),
+        message_count(0),
+        timeout_count(0),
+        queue_(queue),
+        received_(false)
+    {
+    }
+
+    /**
+     * \brief Number of messages received
+     */
+    int message_count;
+
+    /**
+     * \brief Number of timeouts
+     */
+    int timeout_count;
+
+  private:
+    virtual void Run() override
+    {
+        DJETK_CO_BEGIN();
+        while (timeout_count == 0) {
+            DJETK_CO_AWAIT_MESSAGE_FOR(queue_, msg_, 10, received_);
+            if (received_) {
+                message_count++;
+                // Let the other dispatchers run between messages
+                DJETK_CO_YIELD();
+            } else {
+                timeout_count++;
+            }
+        }
+
+        DJETK_CO_AWAIT_DELAY(5);
+        DJETK_CO_END();
+    }
+
+    IMessageQueue &queue_;
+    Message msg_;
+    bool received_;
+};
+
+/**
+ * \test Test that a coroutine suspends on a queue and resumes on messages and
+ *     timeouts
+ */
+void test_Coroutine_AwaitMessageFor_ResumesOnMessageOrTimeout()
+{
+    TickCounterStub tick_counter;
+    MessageQueueStub queue;
+    CoroutineStub coroutine(tick_counter, queue);
+
+    // Nothing to receive yet
+    queue.is_empty = true;
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+
+    queue.is_empty = false;
+    TEST_ASSERT_TRUE(coroutine.TryPoll());
+    TEST_ASSERT_EQUAL(1, coroutine.message_count);
+
+    // The timeout restarts on the next wait
+    queue.is_empty = true;
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+    tick_counter.ticks = 9;
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+    tick_counter.ticks = 10;
+
+    // Times out and goes straight on to wait for the delay before finishing
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+    TEST_ASSERT_EQUAL(1, coroutine.timeout_count);
+    tick_counter.ticks = 14;
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+    tick_counter.ticks = 15;
+    TEST_ASSERT_TRUE(coroutine.TryPoll());
+    TEST_ASSERT_TRUE(coroutine.IsFinished());
+    TEST_ASSERT_FALSE(coroutine.TryPoll());
+}
+
 int main()
 {
     UnityBegin(__FILE__);
     RUN_TEST(test_Poll_PushesMessageFromQueueToHandler);
+    RUN_TEST(test_TryPoll_EmptyQueue_ReturnsFalseWithoutDispatching);
+    RUN_TEST(test_TryPoll_MonitoringEnabled_RecordsPerIdAndReportsSlowHandler);
+    RUN_TEST(test_End_EmptyStatsList_CountsUntracked);
+    RUN_TEST(test_RunOnce_RoundRobin_EachDispatcherServedOncePerPass);
+    RUN_TEST(test_RunOnce_Priority_HigherPriorityDispatcherDrainedFirst);
+    RUN_TEST(test_WakingQueue_MessagePosted_WakesSleeper);
+    RUN_TEST(test_Coroutine_AwaitMessageFor_ResumesOnMessageOrTimeout);
     return UnityEnd();
 }
 
@@ -0,0 +1,25 @@
+#include <messaging/waking-queue.h>
+
+namespace djetk {
+
+bool WakingQueue::PostMessage(const Message &message, uint32_t timeout_ms)
+{
+    if (!queue_.PostMessage(message, timeout_ms)) {
+        return false;
+    }
+
+    sleeper_.Wake();
+    return true;
+}
+
+bool WakingQueue::PostMessageFromIsr(const Message &message, bool &task_woken)
+{
+    if (!queue_.PostMessageFromIsr(message, task_woken)) {
+        return false;
+    }
+
+    sleeper_.WakeFromIsr(task_woken);
+    return true;
+}
+
+}  // namespace djetk
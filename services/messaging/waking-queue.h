@@ -0,0 +1,49 @@
+#ifndef WAKING_QUEUE_H
+#define WAKING_QUEUE_H
+
+#include "messaging/imessage-queue.h"
+#include "messaging/cooperative-executor.h"
+
+namespace djetk {
+
+/**
+ * \brief Message queue that wakes an idle \ref CooperativeExecutor
+ *
+ * Wraps the queue of one of the executor's dispatchers. Every message posted
+ * through it wakes the executor's sleeper, so the executor sleeps until
+ * there is work rather than polling. Receiving is passed straight through.
+ */
+class WakingQueue : public IMessageQueue {
+  public:
+    /**
+     * \brief Constructor
+     * \param[in]   queue       Queue to post to and receive from
+     * \param[in]   sleeper     Sleeper of the executor serving the queue
+     */
+    WakingQueue(IMessageQueue &queue, IIdleSleeper &sleeper)
+        : queue_(queue),
+        sleeper_(sleeper)
+    {
+    }
+
+    virtual bool PostMessage(const Message &message, uint32_t timeout_ms) override;
+    virtual bool PostMessageFromIsr(const Message &message, bool &task_woken) override;
+
+    virtual bool ReceiveMessage(uint32_t timeout_ms, Message &message) override
+    {
+        return queue_.ReceiveMessage(timeout_ms, message);
+    }
+
+    virtual bool ReceiveMessageFromIsr(Message &message, bool &task_woken) override
+    {
+        return queue_.ReceiveMessageFromIsr(message, task_woken);
+    }
+
+  private:
+    IMessageQueue &queue_;
+    IIdleSleeper &sleeper_;
+};
+
+}  // namespace djetk
+
+#endif
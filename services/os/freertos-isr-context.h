@@ -0,0 +1,73 @@
+/**
+    \file
+    \brief FreeRTOS ISR context tracking
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_ISR_CONTEXT_H
+#define FREERTOS_ISR_CONTEXT_H
+
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Marks the code in its scope as running in an ISR
+ *
+ * FreeRTOS has no portable way to tell an ISR from a task, yet critical
+ * sections must use different primitives in each (see
+ * \ref FreeRTOSOsServices). \ref FreeRTOSIsrVector declares one of these
+ * around the ISR service, so everything it invokes, including the tick hook
+ * clients, is known to run in an ISR.
+ */
+class FreeRTOSIsrContext {
+  public:
+    FreeRTOSIsrContext()
+    {
+        Nesting()++;
+    }
+
+    ~FreeRTOSIsrContext()
+    {
+        Nesting()--;
+    }
+
+    /**
+     * \brief Check whether the caller runs in an ISR
+     */
+    static bool IsActive()
+    {
+        return Nesting() != 0;
+    }
+
+  private:
+    /**
+     * \brief Number of nested ISRs currently running
+     */
+    static volatile uint32_t &Nesting()
+    {
+        static volatile uint32_t nesting;
+        return nesting;
+    }
+};
+
+}    // namespace djetk
+
+#endif    // FREERTOS_ISR_CONTEXT_H
@@ -0,0 +1,99 @@
+/**
+    \file
+    \brief FreeRTOS OS services implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include <os/freertos-os-services.h>
+#include <os/freertos-isr-context.h>
+
+namespace djetk {
+
+FreeRTOSOsServices::FreeRTOSOsServices()
+    : mask_level_(0),
+    isr_holds_(0),
+    isr_saved_mask_(0)
+{
+}
+
+void FreeRTOSOsServices::StartScheduler()
+{
+    vTaskStartScheduler();
+}
+
+void FreeRTOSOsServices::StopScheduler()
+{
+    vTaskEndScheduler();
+}
+
+void FreeRTOSOsServices::DisableAllInterrupts()
+{
+    // Nested sections find interrupts disabled already
+    if (GetNesting() == 0) {
+        Hold();
+    }
+}
+
+void FreeRTOSOsServices::EnableAllInterrupts()
+{
+    Release();
+}
+
+void FreeRTOSOsServices::SetInterruptMask(uint32_t level)
+{
+    if ((level != 0) && (mask_level_ == 0)) {
+        Hold();
+    } else if ((level == 0) && (mask_level_ != 0)) {
+        Release();
+    }
+
+    mask_level_ = level;
+}
+
+void FreeRTOSOsServices::Hold()
+{
+    if (!FreeRTOSIsrContext::IsActive()) {
+        // Counted by the kernel along with its own critical sections
+        taskENTER_CRITICAL();
+        return;
+    }
+
+    // Some ports don't restore a nested ISR mask, so only the first holder
+    // sets it
+    if (isr_holds_++ == 0) {
+        isr_saved_mask_ = portSET_INTERRUPT_MASK_FROM_ISR();
+    }
+}
+
+void FreeRTOSOsServices::Release()
+{
+    if (!FreeRTOSIsrContext::IsActive()) {
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    if ((isr_holds_ != 0) && (--isr_holds_ == 0)) {
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(isr_saved_mask_);
+    }
+}
+
+}    // namespace djetk
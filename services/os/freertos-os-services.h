@@ -0,0 +1,91 @@
+/**
+    \file
+    \brief FreeRTOS OS services definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_OS_SERVICES_H
+#define FREERTOS_OS_SERVICES_H
+
+#include <cstdint>
+#include <os/os-services-base.h>
+
+namespace djetk {
+
+/**
+ * \brief FreeRTOS implementation of \ref IOsServices
+ *
+ * - Critical sections may be entered from tasks and ISRs. Tasks enter the
+ *   kernel's critical section, so FreeRTOS API calls made inside one don't
+ *   enable interrupts when they return. ISRs, which are told apart by
+ *   \ref FreeRTOSIsrContext, use the ISR interrupt mask.
+ * - FreeRTOS masks a single level, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ *   which keeps the kernel aware ISRs out. Disabling interrupts and every
+ *   non-zero mask level map to it.
+ * - Disabled and masked sections each hold the hardware mask, so ending one
+ *   leaves interrupts masked while the other is active.
+ *
+ * ISR vectors should end with a context switch when a task was woken (see
+ * \ref FreeRTOSIsrVector).
+ */
+class FreeRTOSOsServices : public OsServicesBase {
+  public:
+    FreeRTOSOsServices();
+
+    /**
+     * \brief See \ref IOsServices::StartScheduler
+     */
+    virtual void StartScheduler() override;
+
+    /**
+     * \brief See \ref IOsServices::StopScheduler
+     */
+    virtual void StopScheduler() override;
+
+  private:
+    virtual void DisableAllInterrupts() override;
+
+    virtual void EnableAllInterrupts() override;
+
+    virtual uint32_t GetInterruptMask() override
+    {
+        return mask_level_;
+    }
+
+    virtual void SetInterruptMask(uint32_t level) override;
+
+    /**
+     * \brief Mask the kernel aware interrupts on behalf of a section
+     */
+    void Hold();
+
+    /**
+     * \brief Release a \ref Hold, unmasking when no other section holds the mask
+     */
+    void Release();
+
+    uint32_t mask_level_;
+    uint32_t isr_holds_;
+    uint32_t isr_saved_mask_;
+};
+
+}    // namespace djetk
+
+#endif    // FREERTOS_OS_SERVICES_H
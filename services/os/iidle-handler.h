@@ -0,0 +1,25 @@
+#ifndef IIDLE_HANDLER_H
+#define IIDLE_HANDLER_H
+
+namespace djetk {
+
+/**
+ * \brief Idle handler interface
+ *
+ * An idle handler registered with the scheduler is invoked whenever no
+ * application task is ready to run.
+ */
+class IIdleHandler {
+  public:
+    /**
+     * \brief Callback invoked from the idle task
+     * \note This function must not block.
+     */
+    virtual void OnIdle() = 0;
+
+    virtual ~IIdleHandler() {}
+};
+
+}   // namespace
+
+#endif
@@ -24,6 +24,8 @@
 #ifndef IOS_SERVICES_H
 #define IOS_SERVICES_H
 
+#include <cstdint>
+
 namespace djetk {
 
 /**
@@ -46,16 +48,66 @@ class IOsServices {
      */
     virtual void DisableInterrupts() = 0;
 
+    /**
+     * \brief Disable global interrupts, recording the call site
+     * \param[in]   file    Source file of the caller
+     * \param[in]   line    Source line of the caller
+     *
+     * Implementations that measure critical sections report the call site
+     * of the longest one. The others ignore it.
+     */
+    virtual void DisableInterruptsAt(const char *file, uint32_t line)
+    {
+        (void)file;
+        (void)line;
+        DisableInterrupts();
+    }
+
     /**
      * \brief Enable global interrupts
      */
     virtual void EnableInterrupts() = 0;
 
+    /**
+     * \brief Mask the interrupts up to a priority level, leaving the higher
+     *        priority interrupts enabled (e.g. BASEPRI on Cortex-M)
+     * \param[in]   level   Interrupts of this logical priority and below
+     *                      are masked. 0 masks nothing.
+     * \return The previous mask, to pass to \ref RestoreInterruptMask
+     *
+     * The mask is never lowered, so masked sections nest.
+     */
+    virtual uint32_t MaskInterrupts(uint32_t level) = 0;
+
+    /**
+     * \brief Mask the interrupts up to a priority level, recording the call site
+     * \param[in]   level   See \ref MaskInterrupts
+     * \param[in]   file    Source file of the caller
+     * \param[in]   line    Source line of the caller
+     * \return The previous mask, to pass to \ref RestoreInterruptMask
+     */
+    virtual uint32_t MaskInterruptsAt(uint32_t level, const char *file, uint32_t line)
+    {
+        (void)file;
+        (void)line;
+        return MaskInterrupts(level);
+    }
+
+    /**
+     * \brief Restore the interrupt mask
+     * \param[in]   previous    Value returned by \ref MaskInterrupts
+     */
+    virtual void RestoreInterruptMask(uint32_t previous) = 0;
+
     virtual ~IOsServices() {}
 };
 
 /**
  * \brief Helper class to enable/disable interrupts in scope
+ *
+ * Helpers nest when the OS services count the nesting (see
+ * \ref OsServicesBase). Use \ref DJETK_AUTO_INTERRUPT_DISABLER to record the
+ * call site.
  */
 class AutoInterruptDisabler {
   public:
@@ -69,6 +121,18 @@ class AutoInterruptDisabler {
         os_services_.DisableInterrupts();
     }
 
+    /**
+     * \brief Constructor disables interrupts, recording the call site
+     * \param[in]   os_services Reference to OS services interface
+     * \param[in]   file        Source file of the caller
+     * \param[in]   line        Source line of the caller
+     */
+    AutoInterruptDisabler(IOsServices &os_services, const char *file, uint32_t line)
+        : os_services_(os_services)
+    {
+        os_services_.DisableInterruptsAt(file, line);
+    }
+
     /**
      * \brief Destructor that disables interrupts
      */
@@ -81,6 +145,61 @@ class AutoInterruptDisabler {
     IOsServices &os_services_;
 };
 
+/**
+ * \brief Helper class to mask interrupts up to a priority level in scope
+ */
+class AutoInterruptMasker {
+  public:
+    /**
+     * \brief Constructor masks the interrupts
+     * \param[in]   os_services Reference to OS services interface
+     * \param[in]   level       See \ref IOsServices::MaskInterrupts
+     */
+    AutoInterruptMasker(IOsServices &os_services, uint32_t level)
+        : os_services_(os_services),
+        previous_(os_services.MaskInterrupts(level))
+    {
+    }
+
+    /**
+     * \brief Constructor masks the interrupts, recording the call site
+     * \param[in]   os_services Reference to OS services interface
+     * \param[in]   level       See \ref IOsServices::MaskInterrupts
+     * \param[in]   file        Source file of the caller
+     * \param[in]   line        Source line of the caller
+     */
+    AutoInterruptMasker(IOsServices &os_services, uint32_t level, const char *file,
+            uint32_t line)
+        : os_services_(os_services),
+        previous_(os_services.MaskInterruptsAt(level, file, line))
+    {
+    }
+
+    /**
+     * \brief Destructor restores the previous mask
+     */
+    ~AutoInterruptMasker()
+    {
+        os_services_.RestoreInterruptMask(previous_);
+    }
+
+  private:
+    IOsServices &os_services_;
+    uint32_t previous_;
+};
+
+/**
+ * \brief Declare an \ref AutoInterruptDisabler named name that records its call site
+ */
+#define DJETK_AUTO_INTERRUPT_DISABLER(name, os_services) \
+    djetk::AutoInterruptDisabler name((os_services), __FILE__, __LINE__)
+
+/**
+ * \brief Declare an \ref AutoInterruptMasker named name that records its call site
+ */
+#define DJETK_AUTO_INTERRUPT_MASKER(name, os_services, level) \
+    djetk::AutoInterruptMasker name((os_services), (level), __FILE__, __LINE__)
+
 }    // namespace djetk
 
 #endif    // IOS_SERVICES_H
@@ -0,0 +1,120 @@
+/**
+    \file
+    \brief OS services base class implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <os/os-services-base.h>
+
+namespace djetk {
+
+OsServicesBase::OsServicesBase()
+    : nesting_(0),
+    cycle_counter_(nullptr),
+    disabled_at_(0),
+    disabled_file_(nullptr),
+    disabled_line_(0),
+    masked_at_(0),
+    masked_file_(nullptr),
+    masked_line_(0)
+{
+}
+
+void OsServicesBase::DisableInterrupts()
+{
+    DisableInterruptsAt(nullptr, 0);
+}
+
+void OsServicesBase::DisableInterruptsAt(const char *file, uint32_t line)
+{
+    DisableAllInterrupts();
+    if (nesting_++ != 0) {
+        return;
+    }
+
+    if (cycle_counter_ != nullptr) {
+        disabled_file_ = file;
+        disabled_line_ = line;
+        disabled_at_ = cycle_counter_->GetCycles();
+    }
+}
+
+void OsServicesBase::EnableInterrupts()
+{
+    if ((nesting_ == 0) || (--nesting_ != 0)) {
+        return;
+    }
+
+    if (cycle_counter_ != nullptr) {
+        Measure(longest_disabled_, disabled_at_, disabled_file_, disabled_line_);
+    }
+
+    EnableAllInterrupts();
+}
+
+uint32_t OsServicesBase::MaskInterrupts(uint32_t level)
+{
+    return MaskInterruptsAt(level, nullptr, 0);
+}
+
+uint32_t OsServicesBase::MaskInterruptsAt(uint32_t level, const char *file, uint32_t line)
+{
+    auto previous = GetInterruptMask();
+    if (level <= previous) {
+        return previous;
+    }
+
+    SetInterruptMask(level);
+    if ((previous == 0) && (cycle_counter_ != nullptr)) {
+        masked_file_ = file;
+        masked_line_ = line;
+        masked_at_ = cycle_counter_->GetCycles();
+    }
+
+    return previous;
+}
+
+void OsServicesBase::RestoreInterruptMask(uint32_t previous)
+{
+    if ((previous == 0) && (cycle_counter_ != nullptr) && (GetInterruptMask() != 0)) {
+        Measure(longest_masked_, masked_at_, masked_file_, masked_line_);
+    }
+
+    SetInterruptMask(previous);
+}
+
+void OsServicesBase::ResetMeasurement()
+{
+    longest_disabled_ = MaskedInterval();
+    longest_masked_ = MaskedInterval();
+}
+
+void OsServicesBase::Measure(MaskedInterval &longest, uint32_t started_at,
+        const char *file, uint32_t line)
+{
+    auto cycles = cycle_counter_->GetCycles() - started_at;
+    if (cycles > longest.cycles) {
+        longest.cycles = cycles;
+        longest.file = file;
+        longest.line = line;
+    }
+}
+
+}    // namespace djetk
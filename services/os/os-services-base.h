@@ -0,0 +1,167 @@
+/**
+    \file
+    \brief OS services base class with nesting and measured critical sections
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OS_SERVICES_BASE_H
+#define OS_SERVICES_BASE_H
+
+#include <cstdint>
+#include <os/ios-services.h>
+#include <profiling/icycle-counter.h>
+
+namespace djetk {
+
+/**
+ * \brief Common implementation of \ref IOsServices critical sections
+ *
+ * Derived classes provide the hardware primitives. This class adds:
+ * - Nesting: interrupts are disabled by the outermost DisableInterrupts and
+ *   enabled by the matching EnableInterrupts only
+ * - Priority masking that never lowers the current mask
+ * - Optional measurement (see \ref EnableMeasurement) of the longest time
+ *   interrupts were disabled or masked, with the call site that started it
+ *
+ * The nesting count is only touched with interrupts disabled, so it's shared
+ * by tasks and ISRs on a single core.
+ */
+class OsServicesBase : public IOsServices {
+  public:
+    /**
+     * \brief Longest interval with interrupts disabled or masked
+     */
+    struct MaskedInterval {
+        MaskedInterval()
+            : cycles(0),
+            file(nullptr),
+            line(0) {}
+
+        /**
+         * \brief Length of the interval
+         */
+        uint32_t cycles;
+
+        /**
+         * \brief Call site that started the interval (nullptr if unknown)
+         */
+        const char *file;
+        uint32_t line;
+    };
+
+    virtual void DisableInterrupts() override;
+
+    virtual void DisableInterruptsAt(const char *file, uint32_t line) override;
+
+    virtual void EnableInterrupts() override;
+
+    virtual uint32_t MaskInterrupts(uint32_t level) override;
+
+    virtual uint32_t MaskInterruptsAt(uint32_t level, const char *file, uint32_t line) override;
+
+    virtual void RestoreInterruptMask(uint32_t previous) override;
+
+    /**
+     * \brief Get the number of nested critical sections currently entered
+     */
+    uint32_t GetNesting() const
+    {
+        return nesting_;
+    }
+
+    /**
+     * \brief Start measuring the critical sections
+     * \param[in]   cycle_counter   Clock to measure with
+     *
+     * Must not be invoked inside a critical section.
+     */
+    void EnableMeasurement(ICycleCounter &cycle_counter)
+    {
+        cycle_counter_ = &cycle_counter;
+    }
+
+    /**
+     * \brief Discard the measured intervals
+     */
+    void ResetMeasurement();
+
+    /**
+     * \brief Get the longest interval with interrupts disabled
+     */
+    const MaskedInterval &GetLongestDisabled() const
+    {
+        return longest_disabled_;
+    }
+
+    /**
+     * \brief Get the longest interval with interrupts masked by priority
+     */
+    const MaskedInterval &GetLongestMasked() const
+    {
+        return longest_masked_;
+    }
+
+  protected:
+    OsServicesBase();
+
+  private:
+    /**
+     * \brief Disable all interrupts in hardware
+     */
+    virtual void DisableAllInterrupts() = 0;
+
+    /**
+     * \brief Enable all interrupts in hardware
+     */
+    virtual void EnableAllInterrupts() = 0;
+
+    /**
+     * \brief Get the current priority mask level (0 if nothing is masked)
+     */
+    virtual uint32_t GetInterruptMask() = 0;
+
+    /**
+     * \brief Set the priority mask level in hardware
+     */
+    virtual void SetInterruptMask(uint32_t level) = 0;
+
+    /**
+     * \brief Update the longest interval
+     */
+    void Measure(MaskedInterval &longest, uint32_t started_at, const char *file,
+            uint32_t line);
+
+    uint32_t nesting_;
+    ICycleCounter *cycle_counter_;
+
+    uint32_t disabled_at_;
+    const char *disabled_file_;
+    uint32_t disabled_line_;
+    MaskedInterval longest_disabled_;
+
+    uint32_t masked_at_;
+    const char *masked_file_;
+    uint32_t masked_line_;
+    MaskedInterval longest_masked_;
+};
+
+}    // namespace djetk
+
+#endif    // OS_SERVICES_BASE_H
@@ -0,0 +1,182 @@
+/**
+    \file
+    \brief FreeRTOS OS services tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-scheduler.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/cycle-counter-stub.h>
+#include <profiling/posix-cycle-counter.h>
+#include <os/freertos-os-services.h>
+#include <FreeRTOS/Source/include/queue.h>
+
+using namespace djetk;
+
+/**
+ * \brief Busy wait for several ticks' worth of real time
+ * \return Number of ticks counted while waiting
+ *
+ * The POSIX port drops the ticks that arrive with interrupts disabled, so no
+ * ticks are counted while the caller is in a critical section.
+ */
+static portTickType SpinTicks()
+{
+    PosixCycleCounter cycle_counter;
+    auto start_tick = xTaskGetTickCount();
+    auto start = cycle_counter.GetCycles();
+    while ((cycle_counter.GetCycles() - start) < (20 * 1000000u)) {
+    }
+
+    return xTaskGetTickCount() - start_tick;
+}
+
+/**
+ * \test Test that critical sections nest and only the outermost one is measured
+ */
+void test_DisableInterrupts_Nested_OutermostSectionMeasured()
+{
+    FreeRTOSOsServices os_services;
+    CycleCounterStub cycle_counter;
+    cycle_counter.step = 10;
+    os_services.EnableMeasurement(cycle_counter);
+
+    os_services.DisableInterruptsAt(__FILE__, 1);
+    os_services.DisableInterruptsAt(__FILE__, 2);
+    TEST_ASSERT_EQUAL(2, os_services.GetNesting());
+    os_services.EnableInterrupts();
+    TEST_ASSERT_EQUAL(1, os_services.GetNesting());
+    os_services.EnableInterrupts();
+    TEST_ASSERT_EQUAL(0, os_services.GetNesting());
+
+    TEST_ASSERT_EQUAL(10, os_services.GetLongestDisabled().cycles);
+    TEST_ASSERT_EQUAL(1, os_services.GetLongestDisabled().line);
+}
+
+/**
+ * \test Test that masked sections nest and restore the previous level
+ */
+void test_MaskInterrupts_Nested_RestoresPreviousLevel()
+{
+    FreeRTOSOsServices os_services;
+
+    auto outer = os_services.MaskInterrupts(3);
+    TEST_ASSERT_EQUAL(0, outer);
+    auto inner = os_services.MaskInterrupts(5);
+    TEST_ASSERT_EQUAL(3, inner);
+
+    // A lower level doesn't unmask anything
+    TEST_ASSERT_EQUAL(5, os_services.MaskInterrupts(1));
+
+    os_services.RestoreInterruptMask(inner);
+    TEST_ASSERT_EQUAL(3, os_services.MaskInterrupts(0));
+    os_services.RestoreInterruptMask(outer);
+    TEST_ASSERT_EQUAL(0, os_services.MaskInterrupts(0));
+}
+
+/**
+ * \test Test that a kernel call inside a critical section doesn't enable interrupts
+ */
+void test_DisableInterrupts_KernelCallInside_StaysDisabled()
+{
+    FreeRTOSOsServices os_services;
+    auto queue = xQueueCreate(1, sizeof(uint32_t));
+    uint32_t value = 1;
+
+    os_services.DisableInterrupts();
+    auto sent = xQueueSend(queue, &value, 0);
+    auto ticks_disabled = SpinTicks();
+    os_services.EnableInterrupts();
+    auto ticks_enabled = SpinTicks();
+    vQueueDelete(queue);
+
+    TEST_ASSERT_EQUAL(pdPASS, sent);
+    TEST_ASSERT_EQUAL(0, ticks_disabled);
+    TEST_ASSERT_TRUE(ticks_enabled > 0);
+}
+
+/**
+ * \test Test that ending a critical section nested in a masked one leaves interrupts masked
+ */
+void test_MaskInterrupts_DisableNestedInside_StaysMaskedAfterEnable()
+{
+    FreeRTOSOsServices os_services;
+
+    auto previous = os_services.MaskInterrupts(3);
+    os_services.DisableInterrupts();
+    os_services.EnableInterrupts();
+    auto ticks_masked = SpinTicks();
+    auto level = os_services.MaskInterrupts(0);
+    os_services.RestoreInterruptMask(previous);
+    auto ticks_unmasked = SpinTicks();
+
+    TEST_ASSERT_EQUAL(0, ticks_masked);
+    TEST_ASSERT_EQUAL(3, level);
+    TEST_ASSERT_TRUE(ticks_unmasked > 0);
+}
+
+/**
+ * \brief FreeRTOS task to run the tests from within
+ *
+ * The task invokes all the test cases before stopping the scheduler, which
+ * terminates the test app.
+ */
+class TestRunnerTask : public FreeRTOSTaskBase {
+  public:
+    TestRunnerTask(ICriticalErrorHandler &error_handler, FreeRTOSScheduler &scheduler)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("RUNNER"),
+            100, tskIDLE_PRIORITY),
+    scheduler_(scheduler)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        RUN_TEST(test_DisableInterrupts_Nested_OutermostSectionMeasured);
+        RUN_TEST(test_MaskInterrupts_Nested_RestoresPreviousLevel);
+        RUN_TEST(test_DisableInterrupts_KernelCallInside_StaysDisabled);
+        RUN_TEST(test_MaskInterrupts_DisableNestedInside_StaysMaskedAfterEnable);
+
+        scheduler_.Stop();
+    }
+
+    FreeRTOSScheduler &scheduler_;
+};
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    auto &scheduler = FreeRTOSScheduler::GetScheduler();
+    CriticalErrorHandlerStub error_handler;
+    TestRunnerTask runner(error_handler, scheduler);
+    scheduler.Start();
+
+    return UnityEnd();
+}
@@ -0,0 +1,172 @@
+/**
+    \file
+    \brief OS services tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <os/os-services-base.h>
+#include <testing/cycle-counter-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief OS services with simulated interrupt hardware
+ */
+class OsServicesBaseStub : public OsServicesBase {
+  public:
+    OsServicesBaseStub()
+        : interrupts_enabled(true),
+        mask(0)
+    {
+    }
+
+    /**
+     * \brief Global interrupt enable state of the simulated hardware
+     */
+    bool interrupts_enabled;
+
+    /**
+     * \brief Priority mask of the simulated hardware
+     */
+    uint32_t mask;
+
+    virtual void StartScheduler() override {}
+    virtual void StopScheduler() override {}
+
+  private:
+    virtual void DisableAllInterrupts() override
+    {
+        interrupts_enabled = false;
+    }
+
+    virtual void EnableAllInterrupts() override
+    {
+        interrupts_enabled = true;
+    }
+
+    virtual uint32_t GetInterruptMask() override
+    {
+        return mask;
+    }
+
+    virtual void SetInterruptMask(uint32_t level) override
+    {
+        mask = level;
+    }
+};
+
+/**
+ * \test Test that nested critical sections enable interrupts on the outermost exit only
+ */
+void test_AutoInterruptDisabler_Nested_EnablesOnOutermostExit()
+{
+    OsServicesBaseStub os_services;
+
+    {
+        AutoInterruptDisabler outer(os_services);
+        {
+            AutoInterruptDisabler inner(os_services);
+            TEST_ASSERT_EQUAL(2, os_services.GetNesting());
+        }
+
+        TEST_ASSERT_FALSE(os_services.interrupts_enabled);
+    }
+
+    TEST_ASSERT_TRUE(os_services.interrupts_enabled);
+    TEST_ASSERT_EQUAL(0, os_services.GetNesting());
+
+    // An unbalanced enable is ignored
+    os_services.EnableInterrupts();
+    TEST_ASSERT_EQUAL(0, os_services.GetNesting());
+}
+
+/**
+ * \test Test that nested masked sections never lower the mask and restore it on exit
+ */
+void test_AutoInterruptMasker_Nested_NeverLowersMask()
+{
+    OsServicesBaseStub os_services;
+
+    {
+        AutoInterruptMasker outer(os_services, 5);
+        {
+            AutoInterruptMasker inner(os_services, 3);
+            TEST_ASSERT_EQUAL(5, os_services.mask);
+        }
+        {
+            AutoInterruptMasker inner(os_services, 7);
+            TEST_ASSERT_EQUAL(7, os_services.mask);
+        }
+
+        TEST_ASSERT_EQUAL(5, os_services.mask);
+        TEST_ASSERT_TRUE(os_services.interrupts_enabled);
+    }
+
+    TEST_ASSERT_EQUAL(0, os_services.mask);
+}
+
+/**
+ * \test Test that the longest critical section is measured with its call site
+ */
+void test_EnableMeasurement_CriticalSections_RecordsLongestWithCallSite()
+{
+    OsServicesBaseStub os_services;
+    CycleCounterStub cycle_counter;
+    os_services.EnableMeasurement(cycle_counter);
+
+    uint32_t long_line = 0;
+    cycle_counter.step = 10;
+    {
+        DJETK_AUTO_INTERRUPT_DISABLER(disabler, os_services);
+    }
+    cycle_counter.step = 50;
+    {
+        long_line = __LINE__ + 1;
+        DJETK_AUTO_INTERRUPT_DISABLER(disabler, os_services);
+        AutoInterruptDisabler nested(os_services);
+    }
+    cycle_counter.step = 20;
+    {
+        DJETK_AUTO_INTERRUPT_MASKER(masker, os_services, 4);
+    }
+
+    auto &disabled = os_services.GetLongestDisabled();
+    TEST_ASSERT_EQUAL(50, disabled.cycles);
+    TEST_ASSERT_EQUAL_STRING(__FILE__, disabled.file);
+    TEST_ASSERT_EQUAL(long_line, disabled.line);
+    TEST_ASSERT_EQUAL(20, os_services.GetLongestMasked().cycles);
+
+    os_services.ResetMeasurement();
+    TEST_ASSERT_EQUAL(0, os_services.GetLongestDisabled().cycles);
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_AutoInterruptDisabler_Nested_EnablesOnOutermostExit);
+    RUN_TEST(test_AutoInterruptMasker_Nested_NeverLowersMask);
+    RUN_TEST(test_EnableMeasurement_CriticalSections_RecordsLongestWithCallSite);
+    return UnityEnd();
+}
@@ -0,0 +1,120 @@
+/**
+    \file
+    \brief Execution time statistics implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <profiling/execution-stats.h>
+
+namespace djetk {
+
+ExecutionStats::ExecutionStats()
+    : budget_(0)
+{
+    Reset();
+}
+
+bool ExecutionStats::Record(uint32_t cycles)
+{
+    if ((count_ == 0) || (cycles < min_)) {
+        min_ = cycles;
+    }
+
+    if (cycles > max_) {
+        max_ = cycles;
+    }
+
+    count_++;
+    total_ += cycles;
+    histogram_[GetBucket(cycles)]++;
+
+    if (budget_ && (cycles > budget_)) {
+        overruns_++;
+        return false;
+    }
+
+    return true;
+}
+
+void ExecutionStats::Reset()
+{
+    count_ = 0;
+    min_ = 0;
+    max_ = 0;
+    total_ = 0;
+    overruns_ = 0;
+    histogram_.fill(0);
+}
+
+uint32_t ExecutionStats::GetMean() const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(total_ / count_);
+}
+
+uint32_t ExecutionStats::GetPercentile(uint32_t percent) const
+{
+    // Number of samples at or below the percentile, rounded up
+    auto target = (static_cast<uint64_t>(count_) * percent + 99) / 100;
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < kHistogramBuckets; bucket++) {
+        cumulative += histogram_[bucket];
+        if ((cumulative >= target) && (cumulative > 0)) {
+            auto upper = GetBucketUpperBound(bucket);
+            return (upper < max_) ? upper : max_;
+        }
+    }
+
+    return max_;
+}
+
+size_t ExecutionStats::GetBucket(uint32_t cycles)
+{
+    if (cycles < kSubBuckets) {
+        return cycles;
+    }
+
+    // Position of the leading one. Counting leading zeros compiles to a
+    // single instruction (CLZ, BSR/LZCNT) instead of a loop in the ISR, and
+    // is defined as cycles isn't zero here.
+    static_assert(sizeof(unsigned int) == sizeof(uint32_t), "__builtin_clz takes a uint32_t");
+    size_t msb = 31 - __builtin_clz(cycles);
+
+    // The bits below the leading one select the bucket within its range
+    auto shift = msb - kSubBucketBits;
+    auto sub_bucket = (cycles >> shift) & (kSubBuckets - 1);
+    return ((shift + 1) * kSubBuckets) + sub_bucket;
+}
+
+uint32_t ExecutionStats::GetBucketUpperBound(size_t bucket)
+{
+    if (bucket < kSubBuckets) {
+        return static_cast<uint32_t>(bucket);
+    }
+
+    auto shift = (bucket / kSubBuckets) - 1;
+    uint64_t lower = static_cast<uint64_t>(kSubBuckets + (bucket % kSubBuckets)) << shift;
+    return static_cast<uint32_t>(lower + (static_cast<uint64_t>(1) << shift) - 1);
+}
+
+}    // namespace djetk
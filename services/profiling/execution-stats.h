@@ -0,0 +1,207 @@
+/**
+    \file
+    \brief Execution time statistics
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EXECUTION_STATS_H
+#define EXECUTION_STATS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utilities/buffptr.h>
+
+namespace djetk {
+
+/**
+ * \brief Execution time statistics of a piece of code
+ *
+ * Keeps the minimum, maximum and mean of the recorded execution times as well
+ * as a log-linear histogram. Each power of two range [2^n, 2^(n+1)) is split
+ * into \ref kSubBuckets buckets of equal width, while values below
+ * \ref kSubBuckets get a bucket each, i.e. buckets 0-3 hold 0-3, bucket 4
+ * holds 4, ..., bucket 8 holds 8-9, bucket 12 holds 16-19 and so on. A bucket
+ * is at most a quarter of its lower bound wide, so percentiles are known to
+ * within 25%, which is fine enough to compare a p99 against a budget. The
+ * buckets cover the full range of a uint32_t, so long execution times (e.g.
+ * nanosecond cycle counters) keep their own buckets.
+ *
+ * A budget can be set on the execution time. Samples that exceed it are
+ * counted as overruns.
+ *
+ * Samples are recorded from ISR context. Readers running in task context
+ * may see a sample half way through being recorded.
+ */
+class ExecutionStats {
+  public:
+    /**
+     * \brief Number of bits of a value below its leading one that select
+     *        its bucket within its power of two range
+     */
+    static constexpr size_t kSubBucketBits = 2;
+
+    /**
+     * \brief Number of buckets each power of two range is split into
+     */
+    static constexpr size_t kSubBuckets = 1u << kSubBucketBits;
+
+    /**
+     * \brief Number of buckets in the histogram
+     */
+    static constexpr size_t kHistogramBuckets = kSubBuckets * (32 - kSubBucketBits + 1);
+
+    /**
+     * \brief Histogram type
+     */
+    typedef std::array<uint32_t, kHistogramBuckets> Histogram;
+
+    /**
+     * \brief Construct empty statistics without a budget
+     */
+    ExecutionStats();
+
+    /**
+     * \brief Record an execution time
+     * \param[in]   cycles  Execution time in cycles
+     * \retval true     The sample is within budget
+     * \retval false    The sample overran the budget
+     */
+    bool Record(uint32_t cycles);
+
+    /**
+     * \brief Discard all the recorded samples. The budget is retained.
+     */
+    void Reset();
+
+    /**
+     * \brief Set the execution time budget
+     * \param[in]   cycles  Budget in cycles. 0 disables the budget.
+     */
+    void SetBudget(uint32_t cycles)
+    {
+        budget_ = cycles;
+    }
+
+    /**
+     * \brief Get the execution time budget in cycles (0 if disabled)
+     */
+    uint32_t GetBudget() const
+    {
+        return budget_;
+    }
+
+    /**
+     * \brief Get the number of recorded samples
+     */
+    uint32_t GetCount() const
+    {
+        return count_;
+    }
+
+    /**
+     * \brief Get the shortest execution time (0 if there are no samples)
+     */
+    uint32_t GetMin() const
+    {
+        return count_ ? min_ : 0;
+    }
+
+    /**
+     * \brief Get the longest execution time
+     */
+    uint32_t GetMax() const
+    {
+        return max_;
+    }
+
+    /**
+     * \brief Get the mean execution time (0 if there are no samples)
+     */
+    uint32_t GetMean() const;
+
+    /**
+     * \brief Get the sum of all the recorded execution times
+     */
+    uint64_t GetTotal() const
+    {
+        return total_;
+    }
+
+    /**
+     * \brief Get the number of samples that overran the budget
+     */
+    uint32_t GetOverrunCount() const
+    {
+        return overruns_;
+    }
+
+    /**
+     * \brief Get the histogram of the execution times
+     */
+    const Histogram &GetHistogram() const
+    {
+        return histogram_;
+    }
+
+    /**
+     * \brief Get an upper bound of a percentile of the execution times
+     *
+     * The percentile is only known to the resolution of the histogram, so
+     * the upper bound of the bucket holding it is returned rather than a
+     * recorded sample. The result is less than 25% above the true
+     * percentile (e.g. 3071 for samples of 2600).
+     *
+     * \param[in]   percent Percentile to get (e.g. 99)
+     * \return The upper bound of the histogram bucket holding the percentile,
+     *         capped at the maximum. 0 if there are no samples.
+     */
+    uint32_t GetPercentile(uint32_t percent) const;
+
+    /**
+     * \brief Get the histogram bucket a value is counted in
+     * \param[in]   cycles  Execution time in cycles
+     */
+    static size_t GetBucket(uint32_t cycles);
+
+    /**
+     * \brief Get the largest value counted in a histogram bucket
+     * \param[in]   bucket  Histogram bucket
+     */
+    static uint32_t GetBucketUpperBound(size_t bucket);
+
+  private:
+    uint32_t count_;
+    uint32_t min_;
+    uint32_t max_;
+    uint64_t total_;
+    uint32_t budget_;
+    uint32_t overruns_;
+    Histogram histogram_;
+};
+
+/**
+ * \brief Buffer pointer to a list (array) of execution statistics
+ */
+typedef buffptr<ExecutionStats> ExecutionStatsList;
+
+}    // namespace djetk
+
+#endif    // EXECUTION_STATS_H
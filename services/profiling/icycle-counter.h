@@ -0,0 +1,52 @@
+/**
+    \file
+    \brief Cycle counter interface
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ICYCLE_COUNTER_H
+#define ICYCLE_COUNTER_H
+
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Interface to a free running cycle counter
+ *
+ * The counter is expected to wrap around at 32 bits. Differences between two
+ * readings are therefore valid as long as the measured interval is shorter
+ * than a full wrap.
+ */
+class ICycleCounter {
+  public:
+    /**
+     * \brief Read the current cycle count
+     *
+     * This function is invoked from ISR context and must not block.
+     */
+    virtual uint32_t GetCycles() = 0;
+
+    virtual ~ICycleCounter() {}
+};
+
+}    // namespace djetk
+
+#endif    // ICYCLE_COUNTER_H
@@ -0,0 +1,137 @@
+/**
+    \file
+    \brief Per interrupt vector profile and report implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <profiling/isr-profile.h>
+
+namespace djetk {
+
+IsrProfile::IsrProfile(const char *name)
+    : name_(name),
+    last_entry_(0),
+    entered_(false),
+    storm_rate_hz_(0),
+    sampled_count_(0),
+    sampled_total_(0),
+    window_count_(0),
+    window_total_(0)
+{
+}
+
+IsrProfileRegistry::IsrProfileRegistry(IsrProfileList &profiles, IOsServices &os_services,
+        uint32_t cycles_per_second)
+    : profiles_(profiles),
+    os_services_(os_services),
+    cycles_per_second_(cycles_per_second),
+    count_(0),
+    last_sample_(0),
+    window_(0)
+{
+}
+
+bool IsrProfileRegistry::Register(IsrProfile &profile)
+{
+    if (count_ == profiles_.size()) {
+        return false;
+    }
+
+    profiles_.data()[count_++] = &profile;
+    return true;
+}
+
+void IsrProfileRegistry::Sample(uint32_t now_cycles)
+{
+    window_ = now_cycles - last_sample_;
+    last_sample_ = now_cycles;
+
+    for (size_t i = 0; i < count_; i++) {
+        auto &profile = *profiles_.data()[i];
+
+        uint32_t count;
+        uint64_t total;
+        {
+            AutoInterruptDisabler disabler(os_services_);
+            count = profile.handler_.GetCount();
+            total = profile.handler_.GetTotal();
+        }
+
+        profile.window_count_ = count - profile.sampled_count_;
+        profile.window_total_ = total - profile.sampled_total_;
+        profile.sampled_count_ = count;
+        profile.sampled_total_ = total;
+    }
+}
+
+size_t IsrProfileRegistry::GetReport(IsrReportList &report) const
+{
+    size_t written = 0;
+    auto data = report.data();
+    if (report.size() == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < count_; i++) {
+        auto &profile = *profiles_.data()[i];
+        IsrReport entry;
+        entry.name = profile.GetName();
+
+        {
+            AutoInterruptDisabler disabler(os_services_);
+            entry.count = profile.handler_.GetCount();
+            entry.max_cycles = profile.handler_.GetMax();
+            entry.mean_cycles = profile.handler_.GetMean();
+            entry.min_inter_arrival = profile.inter_arrival_.GetMin();
+        }
+
+        if (window_ == 0) {
+            entry.rate_hz = 0;
+            entry.cpu_permille = 0;
+        } else {
+            entry.rate_hz = static_cast<uint32_t>(
+                    (static_cast<uint64_t>(profile.window_count_) * cycles_per_second_) / window_);
+            entry.cpu_permille = static_cast<uint32_t>((profile.window_total_ * 1000) / window_);
+        }
+
+        entry.storm = (profile.storm_rate_hz_ != 0) && (entry.rate_hz > profile.storm_rate_hz_);
+
+        // Keep the report sorted by CPU share. Once it is full, the entry
+        // replaces the cheapest one if it costs more.
+        size_t position;
+        if (written < report.size()) {
+            position = written++;
+        } else if (data[written - 1].cpu_permille < entry.cpu_permille) {
+            position = written - 1;
+        } else {
+            continue;
+        }
+
+        while ((position > 0) && (data[position - 1].cpu_permille < entry.cpu_permille)) {
+            data[position] = data[position - 1];
+            position--;
+        }
+        data[position] = entry;
+    }
+
+    return written;
+}
+
+}    // namespace djetk
@@ -0,0 +1,222 @@
+/**
+    \file
+    \brief Per interrupt vector profile and report
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ISR_PROFILE_H
+#define ISR_PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utilities/buffptr.h>
+#include <profiling/execution-stats.h>
+#include <os/ios-services.h>
+
+namespace djetk {
+
+/**
+ * \brief Profile of one interrupt vector
+ *
+ * Records how long the handler runs and the time between interrupts. The
+ * counters are updated from the ISR (see \ref IsrService::EnableAccounting)
+ * and read by \ref IsrProfileRegistry with interrupts disabled.
+ */
+class IsrProfile {
+  public:
+    /**
+     * \brief Construct an empty profile
+     * \param[in]   name    Name of the vector used in reports
+     */
+    explicit IsrProfile(const char *name);
+
+    /**
+     * \brief Record the entry of the ISR
+     * \param[in]   cycles  Cycle count on entry
+     *
+     * Invoked from ISR context.
+     */
+    void RecordEntry(uint32_t cycles)
+    {
+        if (entered_) {
+            inter_arrival_.Record(cycles - last_entry_);
+        }
+
+        last_entry_ = cycles;
+        entered_ = true;
+    }
+
+    /**
+     * \brief Get the execution times of the handler
+     *
+     * A budget set on the returned object flags handlers that take too long.
+     */
+    ExecutionStats &GetHandlerStats()
+    {
+        return handler_;
+    }
+
+    /**
+     * \brief Get the times between consecutive interrupts
+     */
+    const ExecutionStats &GetInterArrivalStats() const
+    {
+        return inter_arrival_;
+    }
+
+    /**
+     * \brief Get the name of the vector
+     */
+    const char *GetName() const
+    {
+        return name_;
+    }
+
+    /**
+     * \brief Set the interrupt rate above which the vector is reported as storming
+     * \param[in]   rate_hz     Interrupts per second. 0 disables the check.
+     */
+    void SetStormRate(uint32_t rate_hz)
+    {
+        storm_rate_hz_ = rate_hz;
+    }
+
+  private:
+    friend class IsrProfileRegistry;
+
+    IsrProfile(const IsrProfile &rhs);
+    const IsrProfile& operator=(const IsrProfile &rhs);
+
+    const char *name_;
+    ExecutionStats handler_;
+    ExecutionStats inter_arrival_;
+    uint32_t last_entry_;
+    bool entered_;
+    uint32_t storm_rate_hz_;
+
+    // Bookkeeping of the registry
+    uint32_t sampled_count_;
+    uint64_t sampled_total_;
+    uint32_t window_count_;
+    uint64_t window_total_;
+};
+
+/**
+ * \brief Collection of interrupt vector profiles for reporting
+ *
+ * A low priority task invokes \ref Sample periodically (e.g. once a second)
+ * and then reads the report, which lists the vectors by their share of the
+ * CPU during the last window.
+ */
+class IsrProfileRegistry {
+  public:
+    /**
+     * \brief Report entry of a vector
+     */
+    struct IsrReport {
+        /**
+         * \brief Vector name
+         */
+        const char *name;
+
+        /**
+         * \brief Total number of interrupts
+         */
+        uint32_t count;
+
+        /**
+         * \brief Interrupts per second during the last window
+         */
+        uint32_t rate_hz;
+
+        /**
+         * \brief Share of the CPU spent in the handler during the last
+         *        window, in tenths of a percent
+         */
+        uint32_t cpu_permille;
+
+        /**
+         * \brief Longest and mean handler execution time in cycles
+         */
+        uint32_t max_cycles;
+        uint32_t mean_cycles;
+
+        /**
+         * \brief Shortest time between two interrupts in cycles
+         */
+        uint32_t min_inter_arrival;
+
+        /**
+         * \brief The rate exceeded the storm rate of the vector
+         */
+        bool storm;
+    };
+
+    /**
+     * \brief Buffer pointer to a list (array) of profiles
+     */
+    typedef buffptr<IsrProfile *> IsrProfileList;
+
+    /**
+     * \brief Buffer pointer to a list (array) of report entries
+     */
+    typedef buffptr<IsrReport> IsrReportList;
+
+    /**
+     * \brief Construct an empty registry
+     * \param[in]   profiles            Storage for the registered profiles
+     * \param[in]   os_services         Services to disable interrupts while
+     *                                  reading the counters
+     * \param[in]   cycles_per_second   Frequency of the cycle counter
+     */
+    IsrProfileRegistry(IsrProfileList &profiles, IOsServices &os_services,
+            uint32_t cycles_per_second);
+
+    /**
+     * \brief Add a profile
+     * \return false if there's no more room
+     */
+    bool Register(IsrProfile &profile);
+
+    /**
+     * \brief Close the current window
+     * \param[in]   now_cycles  Current cycle count
+     */
+    void Sample(uint32_t now_cycles);
+
+    /**
+     * \brief Get the report of the last window, most expensive vector first
+     * \param[out]  report  Buffer to write the report to
+     * \return Number of entries written
+     */
+    size_t GetReport(IsrReportList &report) const;
+
+  private:
+    IsrProfileList &profiles_;
+    IOsServices &os_services_;
+    uint32_t cycles_per_second_;
+    size_t count_;
+    uint32_t last_sample_;
+    uint32_t window_;
+};
+
+}    // namespace djetk
+
+#endif    // ISR_PROFILE_H
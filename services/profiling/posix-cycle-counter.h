@@ -0,0 +1,54 @@
+/**
+    \file
+    \brief Host cycle counter based on the monotonic clock
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef POSIX_CYCLE_COUNTER_H
+#define POSIX_CYCLE_COUNTER_H
+
+#include <time.h>
+#include <profiling/icycle-counter.h>
+
+namespace djetk {
+
+/**
+ * \brief Cycle counter for the POSIX simulator
+ *
+ * There's no portable access to the CPU cycle counter on the host, so one
+ * "cycle" is one nanosecond of CLOCK_MONOTONIC.
+ */
+class PosixCycleCounter : public ICycleCounter {
+  public:
+    /**
+     * \brief See \ref ICycleCounter::GetCycles
+     */
+    virtual uint32_t GetCycles() override
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint32_t>((static_cast<uint64_t>(now.tv_sec) * 1000000000u) +
+                static_cast<uint64_t>(now.tv_nsec));
+    }
+};
+
+}    // namespace djetk
+
+#endif    // POSIX_CYCLE_COUNTER_H
@@ -0,0 +1,62 @@
+/**
+    \file
+    \brief Runtime profile report implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cinttypes>
+#include <profiling/profile-report.h>
+
+namespace djetk {
+
+ProfileReport::ProfileReport(buffptr<char> &buffer)
+    : buffer_(buffer),
+    length_(0)
+{
+    Clear();
+}
+
+bool ProfileReport::Add(Kind kind, const char *name, uint32_t priority,
+        const ExecutionStats &stats, uint32_t rate_hz, uint32_t blocking_cycles)
+{
+    auto remaining = buffer_.size() - length_;
+    auto written = snprintf(buffer_.data() + length_, remaining,
+            "%s,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n",
+            (kind == Kind::isr) ? "isr" : "task", name, priority, stats.GetMax(),
+            rate_hz, blocking_cycles);
+
+    // Drop a truncated line
+    if ((written < 0) || (static_cast<size_t>(written) >= remaining)) {
+        buffer_.data()[length_] = '\0';
+        return false;
+    }
+
+    length_ += written;
+    return true;
+}
+
+void ProfileReport::Clear()
+{
+    length_ = 0;
+    buffer_.front() = '\0';
+}
+
+}    // namespace djetk
@@ -0,0 +1,113 @@
+/**
+    \file
+    \brief Runtime profile report for response time analysis
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILE_REPORT_H
+#define PROFILE_REPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utilities/buffptr.h>
+#include <profiling/execution-stats.h>
+
+namespace djetk {
+
+/**
+ * \brief Text report of measured execution times and arrival rates
+ *
+ * Each ISR and task adds one line with its worst case execution time and
+ * how often it runs. The report is written to an injected buffer and is the
+ * input of tools/response-time-analysis.py, which checks the priority
+ * assignment and the CPU headroom.
+ *
+ * The report is a comma separated list, one line per entry:
+ *
+ *     kind,name,priority,wcet_cycles,rate_hz,blocking_cycles
+ *
+ * where kind is isr or task. Priorities are the ones currently assigned
+ * (higher runs first). Blocking is the longest time the entry blocks others
+ * (e.g. a mutex hold time). The analysis charges it to the higher priority
+ * entries of the same kind, not to the entry itself.
+ */
+class ProfileReport {
+  public:
+    /**
+     * \brief Kind of entry
+     */
+    enum class Kind {
+        isr,
+        task
+    };
+
+    /**
+     * \brief Construct an empty report
+     * \param[in]   buffer  Buffer to write the report to
+     */
+    explicit ProfileReport(buffptr<char> &buffer);
+
+    /**
+     * \brief Add an entry
+     * \param[in]   kind            Kind of entry
+     * \param[in]   name            Entry name, without commas
+     * \param[in]   priority        Currently assigned priority
+     * \param[in]   stats           Execution times of the entry. The maximum is
+     *                              used as the worst case.
+     * \param[in]   rate_hz         Number of activations per second (e.g.
+     *                              \ref ActiveObjectBase::GetMessageRate)
+     * \param[in]   blocking_cycles Longest time the entry blocks others
+     * \return false if the entry doesn't fit in the buffer
+     */
+    bool Add(Kind kind, const char *name, uint32_t priority, const ExecutionStats &stats,
+            uint32_t rate_hz, uint32_t blocking_cycles = 0);
+
+    /**
+     * \brief Remove all the entries
+     */
+    void Clear();
+
+    /**
+     * \brief Get the null terminated report
+     */
+    const char *GetText() const
+    {
+        return buffer_.data();
+    }
+
+    /**
+     * \brief Get the length of the report excluding the terminator
+     */
+    size_t GetLength() const
+    {
+        return length_;
+    }
+
+  private:
+    ProfileReport(const ProfileReport &rhs);
+    const ProfileReport& operator=(const ProfileReport &rhs);
+
+    buffptr<char> &buffer_;
+    size_t length_;
+};
+
+}    // namespace djetk
+
+#endif    // PROFILE_REPORT_H
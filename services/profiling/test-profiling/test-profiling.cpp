@@ -0,0 +1,350 @@
+/**
+    \file
+    \brief Profiling tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <array>
+#include <cstring>
+#include <profiling/execution-stats.h>
+#include <profiling/profile-report.h>
+#include <profiling/isr-profile.h>
+#include <isr/isr-service.h>
+#include <testing/cycle-counter-stub.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/os-services-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief ISR handler stub
+ */
+class IsrHandlerStub : public IIsrHandler {
+  public:
+    IsrHandlerStub()
+        : isr_count(0)
+    {
+    }
+
+    virtual void HandleIsr(bool &task_woken) override
+    {
+        task_woken = false;
+        isr_count++;
+    }
+
+    /**
+     * \brief Number of times the handler was invoked
+     */
+    uint32_t isr_count;
+};
+
+/**
+ * \brief Tag for the \ref IsrService under test
+ */
+class TestDriver;
+
+/**
+ * \test Test that the minimum, maximum and mean of the samples are tracked
+ */
+void test_Record_Samples_TracksMinMaxAndMean()
+{
+    ExecutionStats stats;
+    TEST_ASSERT_EQUAL(0, stats.GetMin());
+    TEST_ASSERT_EQUAL(0, stats.GetMean());
+
+    stats.Record(10);
+    stats.Record(30);
+    stats.Record(20);
+
+    TEST_ASSERT_EQUAL(3, stats.GetCount());
+    TEST_ASSERT_EQUAL(10, stats.GetMin());
+    TEST_ASSERT_EQUAL(30, stats.GetMax());
+    TEST_ASSERT_EQUAL(20, stats.GetMean());
+
+    stats.Reset();
+    TEST_ASSERT_EQUAL(0, stats.GetCount());
+    TEST_ASSERT_EQUAL(0, stats.GetMax());
+}
+
+/**
+ * \test Test that samples are counted in log-linear histogram buckets
+ */
+void test_Record_Samples_CountedInLogLinearBuckets()
+{
+    TEST_ASSERT_EQUAL(0, ExecutionStats::GetBucket(0));
+    TEST_ASSERT_EQUAL(1, ExecutionStats::GetBucket(1));
+    TEST_ASSERT_EQUAL(4, ExecutionStats::GetBucket(4));
+    TEST_ASSERT_EQUAL(7, ExecutionStats::GetBucket(7));
+    TEST_ASSERT_EQUAL(8, ExecutionStats::GetBucket(8));
+    TEST_ASSERT_EQUAL(8, ExecutionStats::GetBucket(9));
+
+    // 16384-20479
+    TEST_ASSERT_EQUAL(52, ExecutionStats::GetBucket(20000));
+    TEST_ASSERT_EQUAL(20479, ExecutionStats::GetBucketUpperBound(52));
+
+    // 1835008-2097151
+    TEST_ASSERT_EQUAL(79, ExecutionStats::GetBucket(2000000));
+    TEST_ASSERT_EQUAL(ExecutionStats::kHistogramBuckets - ExecutionStats::kSubBuckets,
+        ExecutionStats::GetBucket(0x80000000));
+    TEST_ASSERT_EQUAL(ExecutionStats::kHistogramBuckets - 1,
+        ExecutionStats::GetBucket(0xffffffff));
+    TEST_ASSERT_EQUAL(0xffffffff,
+        ExecutionStats::GetBucketUpperBound(ExecutionStats::kHistogramBuckets - 1));
+
+    ExecutionStats stats;
+    stats.Record(5);
+    stats.Record(5);
+    stats.Record(100);
+
+    TEST_ASSERT_EQUAL(2, stats.GetHistogram()[5]);
+
+    // 96-111
+    TEST_ASSERT_EQUAL(1, stats.GetHistogram()[22]);
+}
+
+/**
+ * \test Test that percentiles are bounded by their histogram bucket and the maximum
+ */
+void test_GetPercentile_Samples_ReturnsBucketUpperBound()
+{
+    ExecutionStats stats;
+    TEST_ASSERT_EQUAL(0, stats.GetPercentile(99));
+
+    for (int i = 0; i < 99; i++) {
+        stats.Record(10);
+    }
+    stats.Record(1000);
+
+    // 10-11
+    TEST_ASSERT_EQUAL(11, stats.GetPercentile(50));
+    TEST_ASSERT_EQUAL(11, stats.GetPercentile(99));
+    TEST_ASSERT_EQUAL(1000, stats.GetPercentile(100));
+}
+
+/**
+ * \test Test that the p99 of long execution times doesn't degenerate to the maximum
+ */
+void test_GetPercentile_LongSamples_NotSaturatedAtMax()
+{
+    ExecutionStats stats;
+    for (int i = 0; i < 99; i++) {
+        stats.Record(20000);
+    }
+    stats.Record(3000000000u);
+
+    TEST_ASSERT_EQUAL(20479, stats.GetPercentile(99));
+    TEST_ASSERT_EQUAL(3000000000u, stats.GetPercentile(100));
+}
+
+/**
+ * \test Test that a percentile in the middle of a bucket reads as the bucket upper bound
+ */
+void test_GetPercentile_MidBucketSamples_WithinQuarterOfTruePercentile()
+{
+    ExecutionStats stats;
+    for (uint32_t cycles = 2100; cycles <= 3000; cycles += 100) {
+        stats.Record(cycles);
+    }
+    stats.Record(5000);
+
+    // The p50 (2600) and p90 (3000) share bucket 2560-3071
+    TEST_ASSERT_EQUAL(3071, stats.GetPercentile(50));
+    TEST_ASSERT_EQUAL(3071, stats.GetPercentile(90));
+    TEST_ASSERT_TRUE(stats.GetPercentile(50) < (2600 * 5) / 4);
+    TEST_ASSERT_EQUAL(5000, stats.GetPercentile(100));
+}
+
+/**
+ * \test Test that samples exceeding the budget are counted as overruns
+ */
+void test_Record_SampleExceedsBudget_CountsOverrun()
+{
+    ExecutionStats stats;
+    stats.SetBudget(100);
+
+    TEST_ASSERT_TRUE(stats.Record(100));
+    TEST_ASSERT_FALSE(stats.Record(101));
+    TEST_ASSERT_EQUAL(1, stats.GetOverrunCount());
+}
+
+/**
+ * \test Test that an ISR service with accounting enabled measures its handler
+ */
+void test_IsrService_AccountingEnabled_RecordsHandlerAndReportsOverrun()
+{
+    IsrService<TestDriver> isr_service;
+    IsrHandlerStub handler;
+    CycleCounterStub cycle_counter;
+    CriticalErrorHandlerStub error_handler;
+    ExecutionStats stats;
+
+    isr_service.RegisterHandler(handler);
+    cycle_counter.step = 50;
+    stats.SetBudget(40);
+    isr_service.EnableAccounting(cycle_counter, stats, error_handler);
+
+    bool task_woken;
+    IsrService<TestDriver>::ISR(task_woken);
+
+    TEST_ASSERT_EQUAL(1, handler.isr_count);
+    TEST_ASSERT_EQUAL(50, stats.GetMax());
+    TEST_ASSERT_EQUAL(ICriticalErrorHandler::isr_budget_error, error_handler.last_error_code);
+
+    // The handler is still serviced once accounting is disabled
+    isr_service.DisableAccounting();
+    IsrService<TestDriver>::ISR(task_woken);
+    TEST_ASSERT_EQUAL(2, handler.isr_count);
+    TEST_ASSERT_EQUAL(1, stats.GetCount());
+
+    isr_service.UnregisterHandler();
+}
+
+/**
+ * \test Test that a profiled ISR service records the time between interrupts
+ */
+void test_IsrService_ProfilingEnabled_RecordsInterArrivalTimes()
+{
+    IsrService<TestDriver> isr_service;
+    IsrHandlerStub handler;
+    CycleCounterStub cycle_counter;
+    CriticalErrorHandlerStub error_handler;
+    IsrProfile profile("test");
+
+    isr_service.RegisterHandler(handler);
+    cycle_counter.step = 10;
+    isr_service.EnableAccounting(cycle_counter, profile, error_handler);
+
+    bool task_woken;
+    IsrService<TestDriver>::ISR(task_woken);
+    cycle_counter.cycles += 100;
+    IsrService<TestDriver>::ISR(task_woken);
+
+    TEST_ASSERT_EQUAL(2, profile.GetHandlerStats().GetCount());
+    TEST_ASSERT_EQUAL(10, profile.GetHandlerStats().GetMax());
+    TEST_ASSERT_EQUAL(1, profile.GetInterArrivalStats().GetCount());
+    TEST_ASSERT_EQUAL(120, profile.GetInterArrivalStats().GetMax());
+
+    isr_service.DisableAccounting();
+    isr_service.UnregisterHandler();
+}
+
+/**
+ * \test Test that the report lists the most expensive vectors first and flags storms
+ */
+void test_IsrProfileRegistry_GetReport_SortedByCostWithStorms()
+{
+    OsServicesStub os_services;
+    std::array<IsrProfile *, 3> storage;
+    IsrProfileRegistry::IsrProfileList profiles(storage.data(), storage.size());
+    IsrProfileRegistry registry(profiles, os_services, 1000);
+
+    IsrProfile uart("uart");
+    IsrProfile timer("timer");
+    IsrProfile gpio("gpio");
+    TEST_ASSERT_TRUE(registry.Register(uart));
+    TEST_ASSERT_TRUE(registry.Register(timer));
+    TEST_ASSERT_TRUE(registry.Register(gpio));
+    timer.SetStormRate(10);
+
+    // During a window of 1000 cycles (1 second), the timer fires 20 times
+    // for 5 cycles, the uart once for 200 cycles and the gpio never
+    registry.Sample(0);
+    for (int i = 0; i < 20; i++) {
+        timer.GetHandlerStats().Record(5);
+    }
+    uart.GetHandlerStats().Record(200);
+    registry.Sample(1000);
+
+    std::array<IsrProfileRegistry::IsrReport, 2> entries;
+    IsrProfileRegistry::IsrReportList report(entries.data(), entries.size());
+    TEST_ASSERT_EQUAL(2, registry.GetReport(report));
+
+    TEST_ASSERT_EQUAL_STRING("uart", entries[0].name);
+    TEST_ASSERT_EQUAL(200, entries[0].cpu_permille);
+    TEST_ASSERT_FALSE(entries[0].storm);
+    TEST_ASSERT_EQUAL_STRING("timer", entries[1].name);
+    TEST_ASSERT_EQUAL(20, entries[1].rate_hz);
+    TEST_ASSERT_EQUAL(100, entries[1].cpu_permille);
+    TEST_ASSERT_TRUE(entries[1].storm);
+}
+
+/**
+ * \test Test that an empty report buffer receives no entries
+ */
+void test_IsrProfileRegistry_GetReport_EmptyBuffer_ReturnsZero()
+{
+    OsServicesStub os_services;
+    std::array<IsrProfile *, 1> storage;
+    IsrProfileRegistry::IsrProfileList profiles(storage.data(), storage.size());
+    IsrProfileRegistry registry(profiles, os_services, 1000);
+
+    IsrProfile uart("uart");
+    TEST_ASSERT_TRUE(registry.Register(uart));
+    registry.Sample(0);
+    uart.GetHandlerStats().Record(200);
+    registry.Sample(1000);
+
+    IsrProfileRegistry::IsrReportList report(nullptr, 0);
+    TEST_ASSERT_EQUAL(0, registry.GetReport(report));
+}
+
+/**
+ * \test Test that report entries are formatted and entries that don't fit are dropped
+ */
+void test_ProfileReport_Add_FormatsEntriesUntilFull()
+{
+    char storage[48];
+    buffptr<char> buffer(storage, sizeof(storage));
+    ProfileReport report(buffer);
+    ExecutionStats stats;
+    stats.Record(120);
+    stats.Record(300);
+
+    TEST_ASSERT_TRUE(report.Add(ProfileReport::Kind::isr, "uart", 7, stats, 1000));
+    TEST_ASSERT_TRUE(report.Add(ProfileReport::Kind::task, "ctrl", 2, stats, 50, 10));
+    TEST_ASSERT_EQUAL_STRING("isr,uart,7,300,1000,0\ntask,ctrl,2,300,50,10\n", report.GetText());
+
+    auto length = report.GetLength();
+    TEST_ASSERT_FALSE(report.Add(ProfileReport::Kind::task, "logger", 1, stats, 5));
+    TEST_ASSERT_EQUAL(length, report.GetLength());
+    TEST_ASSERT_EQUAL(length, strlen(report.GetText()));
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_Record_Samples_TracksMinMaxAndMean);
+    RUN_TEST(test_Record_Samples_CountedInLogLinearBuckets);
+    RUN_TEST(test_Record_SampleExceedsBudget_CountsOverrun);
+    RUN_TEST(test_GetPercentile_Samples_ReturnsBucketUpperBound);
+    RUN_TEST(test_GetPercentile_LongSamples_NotSaturatedAtMax);
+    RUN_TEST(test_GetPercentile_MidBucketSamples_WithinQuarterOfTruePercentile);
+    RUN_TEST(test_IsrService_AccountingEnabled_RecordsHandlerAndReportsOverrun);
+    RUN_TEST(test_IsrService_ProfilingEnabled_RecordsInterArrivalTimes);
+    RUN_TEST(test_IsrProfileRegistry_GetReport_SortedByCostWithStorms);
+    RUN_TEST(test_IsrProfileRegistry_GetReport_EmptyBuffer_ReturnsZero);
+    RUN_TEST(test_ProfileReport_Add_FormatsEntriesUntilFull);
+    return UnityEnd();
+}
@@ -0,0 +1,199 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include "sync/freertos-event-group.h"
+#include <timing/freertos-ticks.h>
+
+namespace djetk {
+
+static_assert(FreeRTOSEventGroup::kMaxWaiters <= 32, "Waiters are tracked in a 32 bit mask");
+
+FreeRTOSEventGroup::FreeRTOSEventGroup(ICriticalErrorHandler &error_handler)
+    : error_handler_(error_handler),
+    bits_(0)
+{
+    for (auto &waiter : waiters_) {
+        waiter.in_use = false;
+        waiter.registered = false;
+        waiter.semaphore = xSemaphoreCreateCounting(1, 0);
+        if (waiter.semaphore == 0) {
+            error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+                   __FILE__, __LINE__ );
+        }
+    }
+}
+
+FreeRTOSEventGroup::~FreeRTOSEventGroup()
+{
+    for (auto &waiter : waiters_) {
+        vQueueDelete(waiter.semaphore);
+    }
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::Set(Bits bits)
+{
+    // Keep the waiters from running until all the gives are done, so that a
+    // waiter that times out finds its give already made
+    vTaskSuspendAll();
+    taskENTER_CRITICAL();
+    bits_ |= bits;
+    auto result = bits_;
+    auto wake = TakeWaiters();
+    taskEXIT_CRITICAL();
+
+    for (size_t i = 0; i < kMaxWaiters; i++) {
+        if ((wake & (1u << i)) != 0) {
+            xSemaphoreGive(waiters_[i].semaphore);
+        }
+    }
+    xTaskResumeAll();
+
+    return result;
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::SetFromIsr(Bits bits, bool &task_woken)
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+    auto mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    bits_ |= bits;
+    auto result = bits_;
+    auto wake = TakeWaiters();
+    for (size_t i = 0; i < kMaxWaiters; i++) {
+        if ((wake & (1u << i)) != 0) {
+            xSemaphoreGiveFromISR(waiters_[i].semaphore, &xHigherPriorityTaskWoken);
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        task_woken = true;
+    }
+
+    return result;
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::Clear(Bits bits)
+{
+    taskENTER_CRITICAL();
+    auto result = bits_;
+    bits_ &= ~bits;
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::ClearFromIsr(Bits bits)
+{
+    auto mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    auto result = bits_;
+    bits_ &= ~bits;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return result;
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::WaitAny(Bits bits, uint32_t timeout_ms,
+        bool clear_on_exit)
+{
+    return Wait(bits, false, Ticks(ms_to_FreeRTOSTicks(timeout_ms)), clear_on_exit);
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::WaitAll(Bits bits, uint32_t timeout_ms,
+        bool clear_on_exit)
+{
+    return Wait(bits, true, Ticks(ms_to_FreeRTOSTicks(timeout_ms)), clear_on_exit);
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::WaitAny(Bits bits, Ticks timeout, bool clear_on_exit)
+{
+    return Wait(bits, false, timeout, clear_on_exit);
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::WaitAll(Bits bits, Ticks timeout, bool clear_on_exit)
+{
+    return Wait(bits, true, timeout, clear_on_exit);
+}
+
+IEventGroup::Bits FreeRTOSEventGroup::Wait(Bits bits, bool all, Ticks timeout,
+        bool clear_on_exit)
+{
+    auto start = xTaskGetTickCount();
+    for (;;) {
+        taskENTER_CRITICAL();
+        auto matched = bits_ & bits;
+        if ((all && (matched == bits)) || (!all && (matched != 0))) {
+            if (clear_on_exit) {
+                bits_ &= ~matched;
+            }
+            taskEXIT_CRITICAL();
+            return matched;
+        }
+
+        // Work out how much longer to wait for
+        portTickType wait_ticks = timeout.Count();
+        if (timeout.Count() != Ticks::Infinite().Count()) {
+            auto elapsed = xTaskGetTickCount() - start;
+            wait_ticks = (elapsed < timeout.Count()) ? (timeout.Count() - elapsed) : 0;
+        }
+
+        if (wait_ticks == 0) {
+            taskEXIT_CRITICAL();
+            return 0;
+        }
+
+        auto waiter = AllocateWaiter();
+        taskEXIT_CRITICAL();
+
+        if (waiter == nullptr) {
+            error_handler_.NotifyCriticalError(
+                    ICriticalErrorHandler::service_registration_error, __FILE__, __LINE__);
+            return 0;
+        }
+
+        if (xSemaphoreTake(waiter->semaphore, wait_ticks) != pdPASS) {
+            // Timed out. A setter that unregistered the slot in the meantime
+            // has already given its semaphore, which is taken back so that
+            // the slot is clear for the next waiter.
+            taskENTER_CRITICAL();
+            auto given = !waiter->registered;
+            waiter->registered = false;
+            taskEXIT_CRITICAL();
+
+            if (given) {
+                xSemaphoreTake(waiter->semaphore, 0);
+            }
+        }
+
+        taskENTER_CRITICAL();
+        waiter->in_use = false;
+        taskEXIT_CRITICAL();
+    }
+}
+
+FreeRTOSEventGroup::Waiter *FreeRTOSEventGroup::AllocateWaiter()
+{
+    for (auto &waiter : waiters_) {
+        if (!waiter.in_use) {
+            waiter.in_use = true;
+            waiter.registered = true;
+            return &waiter;
+        }
+    }
+
+    return nullptr;
+}
+
+uint32_t FreeRTOSEventGroup::TakeWaiters()
+{
+    uint32_t wake = 0;
+    for (size_t i = 0; i < kMaxWaiters; i++) {
+        if (waiters_[i].registered) {
+            waiters_[i].registered = false;
+            wake |= 1u << i;
+        }
+    }
+
+    return wake;
+}
+
+}   // namespace djetk
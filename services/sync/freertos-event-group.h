@@ -0,0 +1,132 @@
+#ifndef FREERTOS_EVENT_GROUP_H
+#define FREERTOS_EVENT_GROUP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/semphr.h>
+#include "sync/ievent-group.h"
+#include "timing/freertos-duration.h"
+#include "errors/icritical-error-handler.h"
+
+namespace djetk {
+
+/**
+ * \brief Event group built on a FreeRTOS counting semaphore
+ *
+ * FreeRTOS 6 has no event groups, so the flags are a word protected by a
+ * critical section. Each waiting task takes a slot and blocks on the slot's
+ * semaphore. Setting flags gives the semaphore of every registered slot,
+ * and each woken task checks its own condition again.
+ *
+ * - At most \ref kMaxWaiters tasks may wait on the group at the same time.
+ *   Further waiters are reported to the error handler and return 0.
+ * - A task may be woken without its condition being met, in which case it
+ *   waits again for the remaining time
+ */
+class FreeRTOSEventGroup : public IEventGroup {
+  public:
+    /**
+     * \brief Maximum number of tasks that wait at the same time
+     */
+    static constexpr size_t kMaxWaiters = 8;
+
+    /**
+     * \brief Construct an event group with all flags cleared
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    explicit FreeRTOSEventGroup(ICriticalErrorHandler &error_handler);
+
+    /**
+     * \brief Delete the semaphore
+     */
+    virtual ~FreeRTOSEventGroup();
+
+    virtual Bits Set(Bits bits) override;
+
+    virtual Bits SetFromIsr(Bits bits, bool &task_woken) override;
+
+    virtual Bits Clear(Bits bits) override;
+
+    virtual Bits ClearFromIsr(Bits bits) override;
+
+    virtual Bits Get() const override
+    {
+        return bits_;
+    }
+
+    virtual Bits WaitAny(Bits bits, uint32_t timeout_ms, bool clear_on_exit = true) override;
+
+    virtual Bits WaitAll(Bits bits, uint32_t timeout_ms, bool clear_on_exit = true) override;
+
+    /**
+     * \brief Wait for any of the flags to be set
+     * \param[in]   bits            Flags to wait for
+     * \param[in]   timeout         Time to wait for (e.g. 10_ms or Ticks::Infinite())
+     * \param[in]   clear_on_exit   Clear the matching flags before returning
+     * \return The matching flags, 0 if timed out
+     */
+    Bits WaitAny(Bits bits, Ticks timeout, bool clear_on_exit = true);
+
+    /**
+     * \brief Wait for all of the flags to be set
+     * \param[in]   bits            Flags to wait for
+     * \param[in]   timeout         Time to wait for (e.g. 10_ms or Ticks::Infinite())
+     * \param[in]   clear_on_exit   Clear the flags before returning
+     * \return bits if all of them were set, 0 if timed out
+     */
+    Bits WaitAll(Bits bits, Ticks timeout, bool clear_on_exit = true);
+
+  private:
+    FreeRTOSEventGroup(const FreeRTOSEventGroup &rhs);
+    const FreeRTOSEventGroup& operator=(const FreeRTOSEventGroup &rhs);
+
+    /**
+     * \brief Wait for the flags
+     * \param[in]   bits            Flags to wait for
+     * \param[in]   all             Wait for all rather than any of the flags
+     * \param[in]   timeout         Time to wait for
+     * \param[in]   clear_on_exit   Clear the matching flags before returning
+     */
+    Bits Wait(Bits bits, bool all, Ticks timeout, bool clear_on_exit);
+
+    /**
+     * \brief Semaphore of a waiting task
+     */
+    struct Waiter {
+        xSemaphoreHandle semaphore;
+
+        /**
+         * \brief The slot belongs to a task in \ref Wait
+         */
+        bool in_use;
+
+        /**
+         * \brief The task waits for a give, which hasn't happened yet
+         */
+        bool registered;
+    };
+
+    /**
+     * \brief Take a free slot and register it for the next give.
+     *        Must be invoked in a critical section.
+     * \return nullptr if all the slots are in use
+     */
+    Waiter *AllocateWaiter();
+
+    /**
+     * \brief Unregister all the registered slots.
+     *        Must be invoked in a critical section.
+     * \return Bit mask of the slots to give to
+     */
+    uint32_t TakeWaiters();
+
+    ICriticalErrorHandler &error_handler_;
+    std::array<Waiter, kMaxWaiters> waiters_;
+    volatile Bits bits_;
+};
+
+}   // namespace djetk
+
+#endif
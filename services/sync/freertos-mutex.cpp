@@ -0,0 +1,103 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include "sync/freertos-mutex.h"
+#include <timing/freertos-ticks.h>
+
+namespace djetk {
+
+FreeRTOSMutexBase::FreeRTOSMutexBase(bool recursive, ICriticalErrorHandler &error_handler)
+    : recursive_(recursive),
+    depth_(0),
+    locked_at_(0),
+    holder_(nullptr),
+    cycle_counter_(nullptr)
+{
+    semaphore_ = recursive ? xSemaphoreCreateRecursiveMutex() : xSemaphoreCreateMutex();
+    if (semaphore_ == 0) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+    }
+}
+
+FreeRTOSMutexBase::~FreeRTOSMutexBase()
+{
+    vQueueDelete(semaphore_);
+}
+
+bool FreeRTOSMutexBase::Lock(uint32_t timeout_ms)
+{
+    return Lock(Ticks(ms_to_FreeRTOSTicks(timeout_ms)));
+}
+
+bool FreeRTOSMutexBase::TryLock()
+{
+    return Lock(Ticks(0));
+}
+
+bool FreeRTOSMutexBase::Lock(Ticks timeout)
+{
+    if (cycle_counter_ == nullptr) {
+        return Take(timeout.Count());
+    }
+
+    // Try without blocking first so that a wait can be counted as contended.
+    // Tasks that don't hold the lock update these counters concurrently. The
+    // holder only changes while holding the lock, so it can't be seen to be
+    // the calling task unless it is.
+    if (!Take(0)) {
+        if (holder_ != xTaskGetCurrentTaskHandle()) {
+            taskENTER_CRITICAL();
+            stats_.contended++;
+            taskEXIT_CRITICAL();
+        }
+
+        if ((timeout.Count() == 0) || !Take(timeout.Count())) {
+            taskENTER_CRITICAL();
+            stats_.timeouts++;
+            taskEXIT_CRITICAL();
+            return false;
+        }
+    }
+
+    // Only the outermost lock of a recursive mutex starts a hold
+    if (++depth_ == 1) {
+        stats_.acquisitions++;
+        holder_ = xTaskGetCurrentTaskHandle();
+        locked_at_ = cycle_counter_->GetCycles();
+    }
+
+    return true;
+}
+
+void FreeRTOSMutexBase::Unlock()
+{
+    if ((cycle_counter_ != nullptr) && (depth_ > 0) && (--depth_ == 0)) {
+        auto hold_cycles = cycle_counter_->GetCycles() - locked_at_;
+        if (hold_cycles > stats_.max_hold_cycles) {
+            stats_.max_hold_cycles = hold_cycles;
+        }
+        holder_ = nullptr;
+    }
+
+    Give();
+}
+
+bool FreeRTOSMutexBase::Take(portTickType ticks)
+{
+    if (recursive_) {
+        return xSemaphoreTakeRecursive(semaphore_, ticks) == pdPASS;
+    }
+
+    return xSemaphoreTake(semaphore_, ticks) == pdPASS;
+}
+
+void FreeRTOSMutexBase::Give()
+{
+    if (recursive_) {
+        xSemaphoreGiveRecursive(semaphore_);
+    } else {
+        xSemaphoreGive(semaphore_);
+    }
+}
+
+}   // namespace djetk
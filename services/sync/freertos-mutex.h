@@ -0,0 +1,168 @@
+#ifndef FREERTOS_MUTEX_H
+#define FREERTOS_MUTEX_H
+
+#include <cstdint>
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include <FreeRTOS/Source/include/semphr.h>
+#include "sync/imutex.h"
+#include "timing/freertos-duration.h"
+#include "profiling/icycle-counter.h"
+#include "errors/icritical-error-handler.h"
+
+namespace djetk {
+
+/**
+ * \brief Contention counters of a mutex
+ */
+struct MutexStats {
+    MutexStats()
+        : acquisitions(0),
+        contended(0),
+        timeouts(0),
+        max_hold_cycles(0)
+    {
+    }
+
+    /**
+     * \brief Number of times the lock was acquired
+     */
+    uint32_t acquisitions;
+
+    /**
+     * \brief Number of lock attempts that found the lock held by another task.
+     *        Attempts by the holder to lock a non-recursive mutex again only
+     *        count as timeouts.
+     */
+    uint32_t contended;
+
+    /**
+     * \brief Number of lock attempts that gave up
+     */
+    uint32_t timeouts;
+
+    /**
+     * \brief Longest time the lock was held for
+     */
+    uint32_t max_hold_cycles;
+};
+
+/**
+ * \brief Common implementation of the FreeRTOS mutexes
+ *
+ * FreeRTOS mutexes apply priority inheritance: a low priority task holding
+ * the lock runs at the priority of the highest priority task waiting for it.
+ *
+ * Contention counters are kept once \ref EnableStatistics is invoked. An
+ * uncontended lock then costs an extra non-blocking take and two cycle
+ * counter reads. The hold time is measured from the outermost lock to the
+ * matching unlock. The statistics need INCLUDE_xTaskGetCurrentTaskHandle
+ * to tell the holder apart from other tasks.
+ */
+class FreeRTOSMutexBase : public IMutex {
+  public:
+    virtual ~FreeRTOSMutexBase();
+
+    virtual bool Lock(uint32_t timeout_ms = kWaitForever) override;
+
+    virtual bool TryLock() override;
+
+    virtual void Unlock() override;
+
+    /**
+     * \brief Acquire the lock
+     * \param[in]   timeout     Time to wait for (e.g. 10_ms or Ticks::Infinite())
+     * \return true if the lock was acquired, false if timed out
+     */
+    bool Lock(Ticks timeout);
+
+    /**
+     * \brief Start collecting contention counters
+     * \param[in]   cycle_counter   Counter to measure the hold time with
+     */
+    void EnableStatistics(ICycleCounter &cycle_counter)
+    {
+        cycle_counter_ = &cycle_counter;
+    }
+
+    /**
+     * \brief Get the contention counters
+     */
+    const MutexStats &GetStats() const
+    {
+        return stats_;
+    }
+
+    /**
+     * \brief Reset the contention counters
+     */
+    void ResetStats()
+    {
+        stats_ = MutexStats();
+    }
+
+  protected:
+    /**
+     * \brief Construct the mutex
+     * \param[in]   recursive       Allow the holder to lock again
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    FreeRTOSMutexBase(bool recursive, ICriticalErrorHandler &error_handler);
+
+  private:
+    FreeRTOSMutexBase(const FreeRTOSMutexBase &rhs);
+    const FreeRTOSMutexBase& operator=(const FreeRTOSMutexBase &rhs);
+
+    /**
+     * \brief Take the underlying semaphore
+     */
+    bool Take(portTickType ticks);
+
+    /**
+     * \brief Give the underlying semaphore
+     */
+    void Give();
+
+    xSemaphoreHandle semaphore_;
+    bool recursive_;
+    uint32_t depth_;
+    uint32_t locked_at_;
+    xTaskHandle holder_;
+    ICycleCounter *cycle_counter_;
+    MutexStats stats_;
+};
+
+/**
+ * \brief Mutex with priority inheritance
+ *
+ * Locking the mutex again from the task that holds it blocks until timeout.
+ */
+class FreeRTOSMutex : public FreeRTOSMutexBase {
+  public:
+    /**
+     * \brief Construct the mutex
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    explicit FreeRTOSMutex(ICriticalErrorHandler &error_handler)
+        : FreeRTOSMutexBase(false, error_handler) {}
+};
+
+/**
+ * \brief Mutex with priority inheritance that the holder may lock again
+ *
+ * The lock is released once \ref Unlock was invoked as many times as the
+ * lock was acquired.
+ */
+class FreeRTOSRecursiveMutex : public FreeRTOSMutexBase {
+  public:
+    /**
+     * \brief Construct the mutex
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    explicit FreeRTOSRecursiveMutex(ICriticalErrorHandler &error_handler)
+        : FreeRTOSMutexBase(true, error_handler) {}
+};
+
+}   // namespace djetk
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef IEVENT_GROUP_H
+#define IEVENT_GROUP_H
+
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Group of event flags that tasks can wait on
+ *
+ * Each bit of the group is an independent flag. ISRs and tasks set and clear
+ * flags with a single word update and tasks wait for any or all of a set of
+ * flags. This replaces posting messages for pure signalling.
+ */
+class IEventGroup {
+  public:
+    /**
+     * \brief Event flags type
+     */
+    typedef uint32_t Bits;
+
+    /**
+     * \brief Set flags from task context
+     * \param[in]   bits    Flags to set
+     * \return Flags of the group after setting
+     */
+    virtual Bits Set(Bits bits) = 0;
+
+    /**
+     * \brief Set flags from ISR context
+     * \param[in]   bits        Flags to set
+     * \param[in,out] task_woken Set if rescheduling is required due to a
+     *                          woken up task, otherwise left as is
+     * \return Flags of the group after setting
+     */
+    virtual Bits SetFromIsr(Bits bits, bool &task_woken) = 0;
+
+    /**
+     * \brief Clear flags from task context
+     * \param[in]   bits    Flags to clear
+     * \return Flags of the group before clearing
+     */
+    virtual Bits Clear(Bits bits) = 0;
+
+    /**
+     * \brief Clear flags from ISR context
+     * \param[in]   bits    Flags to clear
+     * \return Flags of the group before clearing
+     */
+    virtual Bits ClearFromIsr(Bits bits) = 0;
+
+    /**
+     * \brief Get the current flags
+     */
+    virtual Bits Get() const = 0;
+
+    /**
+     * \brief Wait for any of the flags to be set
+     * \param[in]   bits            Flags to wait for
+     * \param[in]   timeout_ms      Time to wait for
+     * \param[in]   clear_on_exit   Clear the matching flags before returning
+     * \return The matching flags, 0 if timed out
+     */
+    virtual Bits WaitAny(Bits bits, uint32_t timeout_ms, bool clear_on_exit = true) = 0;
+
+    /**
+     * \brief Wait for all of the flags to be set
+     * \param[in]   bits            Flags to wait for
+     * \param[in]   timeout_ms      Time to wait for
+     * \param[in]   clear_on_exit   Clear the flags before returning
+     * \return bits if all of them were set, 0 if timed out
+     */
+    virtual Bits WaitAll(Bits bits, uint32_t timeout_ms, bool clear_on_exit = true) = 0;
+
+    virtual ~IEventGroup() {}
+};
+
+}   // namespace djetk
+
+#endif
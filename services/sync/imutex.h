@@ -0,0 +1,44 @@
+#ifndef IMUTEX_H
+#define IMUTEX_H
+
+#include <cstdint>
+#include <limits>
+
+namespace djetk {
+
+/**
+ * \brief Mutual exclusion lock shared between tasks
+ *
+ * Mutexes may only be used from task context.
+ */
+class IMutex {
+  public:
+    /**
+     * \brief Timeout value to wait for the lock indefinitely
+     */
+    static constexpr uint32_t kWaitForever = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * \brief Acquire the lock
+     * \param[in]   timeout_ms  Time to wait for the lock
+     * \return true if the lock was acquired, false if timed out
+     */
+    virtual bool Lock(uint32_t timeout_ms = kWaitForever) = 0;
+
+    /**
+     * \brief Acquire the lock if it is free
+     * \return true if the lock was acquired
+     */
+    virtual bool TryLock() = 0;
+
+    /**
+     * \brief Release the lock
+     */
+    virtual void Unlock() = 0;
+
+    virtual ~IMutex() {}
+};
+
+}   // namespace djetk
+
+#endif
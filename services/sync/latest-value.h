@@ -0,0 +1,171 @@
+#ifndef LATEST_VALUE_H
+#define LATEST_VALUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace djetk {
+
+/**
+ * \brief Channel that holds the latest value published by one writer,
+ *        protected by a sequence counter (seqlock)
+ *
+ * The writer never waits. Readers copy the value and retry if the writer
+ * updated it in the meantime, so they always see a consistent snapshot.
+ * Neither side disables interrupts.
+ *
+ * - There must be a single writer, and it must not be preempted by a reader
+ *   that uses \ref Read (e.g. the writer is an ISR and readers are tasks).
+ *   A reader that may preempt the writer must use \ref TryRead instead.
+ * - T must be trivially copyable. Large values make readers retry more often;
+ *   prefer \ref TripleBufferLatestValue for those.
+ */
+template<typename T>
+class SeqlockLatestValue {
+    static_assert(std::is_trivially_copyable<T>::value,
+            "Values are copied while they may be written");
+
+  public:
+    SeqlockLatestValue()
+        : sequence_(0),
+        value_() {}
+
+    /**
+     * \brief Publish a new value
+     * \param[in]   value   Value to publish
+     */
+    void Write(const T &value)
+    {
+        auto sequence = sequence_.load(std::memory_order_relaxed);
+
+        // An odd sequence marks the write in progress
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        value_ = value;
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * \brief Copy the latest value, retrying while it is being written
+     * \param[out]  value   The latest value
+     * \return The sequence number of the value, which changes with each write
+     */
+    uint32_t Read(T &value) const
+    {
+        uint32_t sequence;
+        while (!TryRead(value, sequence)) {
+        }
+
+        return sequence;
+    }
+
+    /**
+     * \brief Copy the latest value unless it is being written
+     * \param[out]  value       The latest value
+     * \param[out]  sequence    The sequence number of the value
+     * \return true if a consistent value was copied
+     */
+    bool TryRead(T &value, uint32_t &sequence) const
+    {
+        auto before = sequence_.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            return false;
+        }
+
+        value = value_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        sequence = before;
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+  private:
+    std::atomic<uint32_t> sequence_;
+    T value_;
+};
+
+/**
+ * \brief Channel that holds the latest value published by one writer,
+ *        using three buffers
+ *
+ * The writer fills a back buffer and swaps it with the middle buffer. The
+ * reader swaps the middle buffer with its front buffer when a new value is
+ * available. Both sides finish in a bounded number of steps regardless of
+ * what the other side is doing, so either may be an ISR.
+ *
+ * - There must be a single writer and a single reader
+ * - The reader's buffer stays valid until its next \ref Read
+ */
+template<typename T>
+class TripleBufferLatestValue {
+  public:
+    TripleBufferLatestValue()
+        : middle_(1),
+        back_(0),
+        front_(2) {}
+
+    /**
+     * \brief Get the buffer to fill with the next value
+     *
+     * Fill the buffer and invoke \ref Publish to make it the latest value.
+     */
+    T &GetWriteBuffer()
+    {
+        return buffers_[back_];
+    }
+
+    /**
+     * \brief Make the write buffer the latest value
+     */
+    void Publish()
+    {
+        back_ = middle_.exchange(back_ | kNewFlag, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /**
+     * \brief Publish a new value
+     * \param[in]   value   Value to publish
+     */
+    void Write(const T &value)
+    {
+        GetWriteBuffer() = value;
+        Publish();
+    }
+
+    /**
+     * \brief Get the latest value
+     * \param[out]  is_new  Set if the value was published since the last read
+     * \return Reference to the latest value
+     */
+    const T &Read(bool &is_new)
+    {
+        is_new = (middle_.load(std::memory_order_relaxed) & kNewFlag) != 0;
+        if (is_new) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        return buffers_[front_];
+    }
+
+    /**
+     * \brief Get the latest value
+     */
+    const T &Read()
+    {
+        bool is_new;
+        return Read(is_new);
+    }
+
+  private:
+    static constexpr uint8_t kIndexMask = 0x03;
+    static constexpr uint8_t kNewFlag = 0x04;
+
+    T buffers_[3];
+    std::atomic<uint8_t> middle_;
+    uint8_t back_;
+    uint8_t front_;
+};
+
+}   // namespace djetk
+
+#endif
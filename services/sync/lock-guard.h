@@ -0,0 +1,65 @@
+#ifndef LOCK_GUARD_H
+#define LOCK_GUARD_H
+
+#include "sync/imutex.h"
+
+namespace djetk {
+
+/**
+ * \brief Helper class to hold a mutex in scope
+ *
+ * The timed constructor may fail to acquire the lock. Check \ref OwnsLock
+ * before touching the protected data.
+ */
+class LockGuard {
+  public:
+    /**
+     * \brief Constructor waits for the lock indefinitely
+     * \param[in]   mutex   Mutex to hold
+     */
+    explicit LockGuard(IMutex &mutex)
+        : mutex_(mutex),
+        owns_lock_(mutex.Lock())
+    {
+    }
+
+    /**
+     * \brief Constructor waits for the lock for a limited time
+     * \param[in]   mutex       Mutex to hold
+     * \param[in]   timeout_ms  Time to wait for the lock
+     */
+    LockGuard(IMutex &mutex, uint32_t timeout_ms)
+        : mutex_(mutex),
+        owns_lock_(mutex.Lock(timeout_ms))
+    {
+    }
+
+    /**
+     * \brief Destructor releases the lock if it was acquired
+     */
+    ~LockGuard()
+    {
+        if (owns_lock_) {
+            mutex_.Unlock();
+        }
+    }
+
+    /**
+     * \brief Check whether the lock was acquired
+     */
+    bool OwnsLock() const
+    {
+        return owns_lock_;
+    }
+
+  private:
+    LockGuard(const LockGuard &rhs);
+    const LockGuard& operator=(const LockGuard &rhs);
+
+    IMutex &mutex_;
+    bool owns_lock_;
+};
+
+}   // namespace djetk
+
+#endif
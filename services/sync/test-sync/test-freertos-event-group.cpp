@@ -0,0 +1,255 @@
+/**
+ * \file
+ * Test cases to validate the FreeRTOSEventGroup
+ */
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <array>
+#include <memory>
+#include <FreeRTOS/Source/include/task.h>
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-scheduler.h>
+#include <testing/critical-error-handler-stub.h>
+#include <sync/freertos-event-group.h>
+
+using namespace djetk;
+
+/**
+ * \brief Task that sets flags of an event group after a delay
+ */
+class SetterTask : public FreeRTOSTaskBase {
+  public:
+    SetterTask(ICriticalErrorHandler &error_handler, IEventGroup &group,
+            IEventGroup::Bits bits, portTickType delay = 2)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("SETTER"),
+            100, tskIDLE_PRIORITY + 1),
+    group_(group),
+    bits_(bits),
+    delay_(delay)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        vTaskDelay(delay_);
+        group_.Set(bits_);
+
+        for (;;) {
+            vTaskDelay(portMAX_DELAY);
+        }
+    }
+
+    IEventGroup &group_;
+    IEventGroup::Bits bits_;
+    portTickType delay_;
+};
+
+/**
+ * \brief Task that waits for flags of an event group without a timeout
+ *
+ * The task runs at a higher priority than the test runner, so it blocks in
+ * the group as soon as it is created.
+ */
+class WaiterTask : public FreeRTOSTaskBase {
+  public:
+    WaiterTask(ICriticalErrorHandler &error_handler, FreeRTOSEventGroup &group,
+            IEventGroup::Bits bits)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("WAITER"),
+            100, tskIDLE_PRIORITY + 2),
+    result(0),
+    group_(group),
+    bits_(bits)
+    {
+    }
+
+    /**
+     * \brief Flags returned by the wait
+     */
+    volatile IEventGroup::Bits result;
+
+ private:
+    virtual void TaskMain()
+    {
+        result = group_.WaitAny(bits_, Ticks::Infinite(), false);
+
+        for (;;) {
+            vTaskDelay(portMAX_DELAY);
+        }
+    }
+
+    FreeRTOSEventGroup &group_;
+    IEventGroup::Bits bits_;
+};
+
+/**
+ * \brief Test that waiting for any flag returns the flags that are set
+ */
+void test_WaitAny_OneFlagSet_ReturnsSetFlag()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+
+    group.Set(0x02);
+    TEST_ASSERT_EQUAL(0x02, group.WaitAny(0x06, 0));
+    TEST_ASSERT_EQUAL(0, group.Get());
+}
+
+/**
+ * \brief Test that waiting for all flags times out when only some are set
+ */
+void test_WaitAll_SomeFlagsSet_TimesOut()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+
+    group.Set(0x01);
+    TEST_ASSERT_EQUAL(0, group.WaitAll(0x03, Ticks(2)));
+    TEST_ASSERT_EQUAL(0x01, group.Get());
+}
+
+/**
+ * \brief Test that flags set from an ISR satisfy a wait for all and are cleared on exit
+ */
+void test_WaitAll_SetFromIsr_ReturnsAndClearsFlags()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+
+    bool task_woken = true;
+    group.SetFromIsr(0x01, task_woken);
+    TEST_ASSERT_FALSE(task_woken);
+    group.SetFromIsr(0x02, task_woken);
+
+    TEST_ASSERT_EQUAL(0x03, group.WaitAll(0x03, 0, true));
+    TEST_ASSERT_EQUAL(0, group.Get());
+}
+
+/**
+ * \brief Test that a blocked waiter is woken when another task sets the flag
+ */
+void test_WaitAny_SetByOtherTask_WakesWaiter()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+    SetterTask setter(error_handler, group, 0x10);
+
+    TEST_ASSERT_EQUAL(0x10, group.WaitAny(0x10, Ticks(100)));
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that a waiter beyond the maximum is rejected and all the others wake
+ */
+void test_WaitAny_TooManyWaiters_ExtraRejectedAndAllOthersWoken()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+
+    std::array<std::unique_ptr<WaiterTask>, FreeRTOSEventGroup::kMaxWaiters> waiters;
+    for (auto &waiter : waiters) {
+        waiter.reset(new WaiterTask(error_handler, group, 0x01));
+    }
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+
+    TEST_ASSERT_EQUAL(0, group.WaitAny(0x01, Ticks(2)));
+    TEST_ASSERT_TRUE(error_handler.is_critical_error);
+    TEST_ASSERT_EQUAL(ICriticalErrorHandler::service_registration_error,
+            error_handler.last_error_code);
+
+    // The waiters run at a higher priority, so they return before Set does
+    group.Set(0x01);
+    for (auto &waiter : waiters) {
+        TEST_ASSERT_EQUAL(0x01, waiter->result);
+    }
+}
+
+/**
+ * \brief Test that a waiter timing out doesn't affect the registration of another
+ */
+void test_WaitAny_OtherWaiterTimesOut_WaiterStillWoken()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSEventGroup group(error_handler);
+    WaiterTask waiter(error_handler, group, 0x01);
+
+    // Wake the waiter without meeting its condition, so it registers again,
+    // then time out while it waits
+    group.Set(0x02);
+    TEST_ASSERT_EQUAL(0, group.WaitAny(0x04, Ticks(2)));
+    TEST_ASSERT_EQUAL(0, waiter.result);
+
+    // A flag set well before the timeout satisfies the wait
+    SetterTask setter(error_handler, group, 0x08, 2);
+    TEST_ASSERT_EQUAL(0x08, group.WaitAny(0x08, Ticks(10)));
+
+    // A flag set well after the timeout is left for the next wait
+    SetterTask late_setter(error_handler, group, 0x10, 10);
+    TEST_ASSERT_EQUAL(0, group.WaitAny(0x10, Ticks(2)));
+    TEST_ASSERT_EQUAL(0x10, group.WaitAny(0x10, Ticks(20)));
+
+    group.Set(0x01);
+    TEST_ASSERT_EQUAL(0x01, waiter.result);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief FreeRTOS task to run the tests from within
+ *  The task invokes all the test cases define above before stopping the
+ *  scheduler (thus terminating the test app)
+ */
+class TestRunnerTask : public FreeRTOSTaskBase {
+  public:
+    /**
+     * \brief Construct a FreeRTOS task
+     * \param[in] error_handler Error handler callback interface
+     * \param[in] scheduler     Referenec to the FreeRTOS scheduler
+     * Failure to allocate/start the task results in the error_handler
+     * being invoked.
+     */
+    TestRunnerTask(ICriticalErrorHandler &error_handler, FreeRTOSScheduler &scheduler)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("RUNNER"),
+            100, tskIDLE_PRIORITY),
+    scheduler_(scheduler)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        RUN_TEST(test_WaitAny_OneFlagSet_ReturnsSetFlag);
+        RUN_TEST(test_WaitAll_SomeFlagsSet_TimesOut);
+        RUN_TEST(test_WaitAll_SetFromIsr_ReturnsAndClearsFlags);
+        RUN_TEST(test_WaitAny_SetByOtherTask_WakesWaiter);
+        RUN_TEST(test_WaitAny_TooManyWaiters_ExtraRejectedAndAllOthersWoken);
+        RUN_TEST(test_WaitAny_OtherWaiterTimesOut_WaiterStillWoken);
+
+        scheduler_.Stop();
+    }
+
+    FreeRTOSScheduler &scheduler_;
+};
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    auto &scheduler = FreeRTOSScheduler::GetScheduler();
+
+    // Create the test runner task. Once the scheduler starts, this task begins
+    // executing all the test cases. In the end the runner disables the scheduler
+    // bringing execution back here.
+    CriticalErrorHandlerStub error_handler;
+    TestRunnerTask runner(error_handler, scheduler);
+
+    // The task should start when we start the scheduler
+    scheduler.Start();
+
+    return UnityEnd();
+}
@@ -0,0 +1,274 @@
+/**
+ * \file
+ * Test cases to validate the FreeRTOSMutex and FreeRTOSRecursiveMutex
+ */
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-scheduler.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/cycle-counter-stub.h>
+#include <sync/freertos-mutex.h>
+#include <sync/lock-guard.h>
+
+using namespace djetk;
+
+/**
+ * \brief Test that an uncontended lock counts the acquisition and hold time
+ */
+void test_Lock_Uncontended_CountsAcquisitionAndHoldTime()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    cycle_counter.step = 50;
+    FreeRTOSMutex mutex(error_handler);
+    mutex.EnableStatistics(cycle_counter);
+
+    TEST_ASSERT_TRUE(mutex.Lock());
+    mutex.Unlock();
+
+    TEST_ASSERT_EQUAL(1, mutex.GetStats().acquisitions);
+    TEST_ASSERT_EQUAL(0, mutex.GetStats().contended);
+    TEST_ASSERT_EQUAL(50, mutex.GetStats().max_hold_cycles);
+}
+
+/**
+ * \brief Test that the holder locking a mutex again fails without counting
+ *        contention
+ */
+void test_TryLock_HeldByCaller_FailsWithoutCountingContention()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    FreeRTOSMutex mutex(error_handler);
+    mutex.EnableStatistics(cycle_counter);
+
+    TEST_ASSERT_TRUE(mutex.TryLock());
+    TEST_ASSERT_FALSE(mutex.TryLock());
+    TEST_ASSERT_FALSE(mutex.Lock(Ticks(2)));
+    mutex.Unlock();
+
+    TEST_ASSERT_EQUAL(1, mutex.GetStats().acquisitions);
+    TEST_ASSERT_EQUAL(0, mutex.GetStats().contended);
+    TEST_ASSERT_EQUAL(2, mutex.GetStats().timeouts);
+}
+
+/**
+ * \brief Priority of the task that holds the mutex in the inheritance test
+ */
+static constexpr unsigned portBASE_TYPE kLowPriority = tskIDLE_PRIORITY + 1;
+
+/**
+ * \brief Priority of the task that waits for the mutex in the inheritance test
+ */
+static constexpr unsigned portBASE_TYPE kHighPriority = tskIDLE_PRIORITY + 3;
+
+/**
+ * \brief Task that locks a mutex and suspends itself until resumed
+ *
+ * Records its priority while holding the lock after being resumed and
+ * after releasing it.
+ */
+class LowPriorityHolderTask : public FreeRTOSTaskBase {
+  public:
+    LowPriorityHolderTask(ICriticalErrorHandler &error_handler, FreeRTOSMutex &mutex)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("HOLDER"),
+            100, kLowPriority),
+    held_priority(0),
+    released_priority(0),
+    mutex_(mutex)
+    {
+    }
+
+    /**
+     * \brief Priority while holding the lock after being resumed
+     */
+    volatile unsigned portBASE_TYPE held_priority;
+
+    /**
+     * \brief Priority after releasing the lock
+     */
+    volatile unsigned portBASE_TYPE released_priority;
+
+ private:
+    virtual void TaskMain()
+    {
+        mutex_.Lock();
+        vTaskSuspend(NULL);
+
+        held_priority = uxTaskPriorityGet(NULL);
+        mutex_.Unlock();
+        released_priority = uxTaskPriorityGet(NULL);
+
+        for (;;) {
+            vTaskSuspend(NULL);
+        }
+    }
+
+    FreeRTOSMutex &mutex_;
+};
+
+/**
+ * \brief Task that waits for a mutex without a timeout
+ */
+class HighPriorityWaiterTask : public FreeRTOSTaskBase {
+  public:
+    HighPriorityWaiterTask(ICriticalErrorHandler &error_handler, FreeRTOSMutex &mutex)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("WAITER"),
+            100, kHighPriority),
+    acquired(false),
+    mutex_(mutex)
+    {
+    }
+
+    /**
+     * \brief Set once the lock was acquired
+     */
+    volatile bool acquired;
+
+ private:
+    virtual void TaskMain()
+    {
+        acquired = mutex_.Lock(Ticks::Infinite());
+        mutex_.Unlock();
+
+        for (;;) {
+            vTaskSuspend(NULL);
+        }
+    }
+
+    FreeRTOSMutex &mutex_;
+};
+
+/**
+ * \brief Test that a low priority holder inherits the priority of a high
+ *        priority task waiting for the lock until it releases the lock
+ *
+ * Both tasks run at a higher priority than the test runner, so each one runs
+ * as soon as it is created or resumed.
+ */
+void test_Lock_HighPriorityWaiter_HolderInheritsPriority()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    FreeRTOSMutex mutex(error_handler);
+    mutex.EnableStatistics(cycle_counter);
+
+    // The holder takes the lock and suspends, then the waiter blocks on it
+    LowPriorityHolderTask holder(error_handler, mutex);
+    HighPriorityWaiterTask waiter(error_handler, mutex);
+    TEST_ASSERT_FALSE(waiter.acquired);
+    TEST_ASSERT_EQUAL(1, mutex.GetStats().contended);
+
+    // The holder runs boosted until it releases the lock to the waiter
+    holder.Resume();
+    TEST_ASSERT_EQUAL(kHighPriority, holder.held_priority);
+    TEST_ASSERT_EQUAL(kLowPriority, holder.released_priority);
+    TEST_ASSERT_TRUE(waiter.acquired);
+
+    TEST_ASSERT_EQUAL(2, mutex.GetStats().acquisitions);
+    TEST_ASSERT_EQUAL(0, mutex.GetStats().timeouts);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that a recursive mutex is held until unlocked as often as it was locked
+ */
+void test_Unlock_RecursiveMutexLockedTwice_ReleasedOnLastUnlock()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    cycle_counter.step = 10;
+    FreeRTOSRecursiveMutex mutex(error_handler);
+    mutex.EnableStatistics(cycle_counter);
+
+    TEST_ASSERT_TRUE(mutex.Lock());
+    TEST_ASSERT_TRUE(mutex.TryLock());
+    mutex.Unlock();
+    mutex.Unlock();
+
+    TEST_ASSERT_EQUAL(1, mutex.GetStats().acquisitions);
+    TEST_ASSERT_EQUAL(0, mutex.GetStats().contended);
+    TEST_ASSERT_EQUAL(10, mutex.GetStats().max_hold_cycles);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that the lock guard releases the mutex at the end of its scope
+ */
+void test_LockGuard_EndOfScope_ReleasesMutex()
+{
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSMutex mutex(error_handler);
+
+    {
+        LockGuard guard(mutex);
+        TEST_ASSERT_TRUE(guard.OwnsLock());
+
+        LockGuard timed_guard(mutex, 0);
+        TEST_ASSERT_FALSE(timed_guard.OwnsLock());
+    }
+
+    TEST_ASSERT_TRUE(mutex.TryLock());
+    mutex.Unlock();
+}
+
+/**
+ * \brief FreeRTOS task to run the tests from within
+ *  The task invokes all the test cases define above before stopping the
+ *  scheduler (thus terminating the test app)
+ */
+class TestRunnerTask : public FreeRTOSTaskBase {
+  public:
+    /**
+     * \brief Construct a FreeRTOS task
+     * \param[in] error_handler Error handler callback interface
+     * \param[in] scheduler     Referenec to the FreeRTOS scheduler
+     * Failure to allocate/start the task results in the error_handler
+     * being invoked.
+     */
+    TestRunnerTask(ICriticalErrorHandler &error_handler, FreeRTOSScheduler &scheduler)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("RUNNER"),
+            100, tskIDLE_PRIORITY),
+    scheduler_(scheduler)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        RUN_TEST(test_Lock_Uncontended_CountsAcquisitionAndHoldTime);
+        RUN_TEST(test_TryLock_HeldByCaller_FailsWithoutCountingContention);
+        RUN_TEST(test_Lock_HighPriorityWaiter_HolderInheritsPriority);
+        RUN_TEST(test_Unlock_RecursiveMutexLockedTwice_ReleasedOnLastUnlock);
+        RUN_TEST(test_LockGuard_EndOfScope_ReleasesMutex);
+
+        scheduler_.Stop();
+    }
+
+    FreeRTOSScheduler &scheduler_;
+};
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    auto &scheduler = FreeRTOSScheduler::GetScheduler();
+
+    // Create the test runner task. Once the scheduler starts, this task begins
+    // executing all the test cases. In the end the runner disables the scheduler
+    // bringing execution back here.
+    CriticalErrorHandlerStub error_handler;
+    TestRunnerTask runner(error_handler, scheduler);
+
+    // The task should start when we start the scheduler
+    scheduler.Start();
+
+    return UnityEnd();
+}
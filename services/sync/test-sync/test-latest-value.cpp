@@ -0,0 +1,73 @@
+/**
+ * \file
+ * Test cases to validate the latest value channels
+ */
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <sync/latest-value.h>
+
+using namespace djetk;
+
+/**
+ * \brief Multi-word sample used as the channel value
+ */
+struct Sample {
+    uint32_t x;
+    uint32_t y;
+    uint32_t z;
+};
+
+/**
+ * \brief Test that a seqlock reader sees the last value written
+ */
+void test_SeqlockRead_AfterWrites_ReturnsLatestValueAndSequence()
+{
+    SeqlockLatestValue<Sample> channel;
+
+    channel.Write(Sample{1, 2, 3});
+    channel.Write(Sample{4, 5, 6});
+
+    Sample sample;
+    TEST_ASSERT_EQUAL(4, channel.Read(sample));
+    TEST_ASSERT_EQUAL(4, sample.x);
+    TEST_ASSERT_EQUAL(6, sample.z);
+
+    uint32_t sequence;
+    TEST_ASSERT_TRUE(channel.TryRead(sample, sequence));
+    TEST_ASSERT_EQUAL(4, sequence);
+}
+
+/**
+ * \brief Test that a triple buffer reader only flags values it hasn't read yet
+ */
+void test_TripleBufferRead_NewValue_FlaggedOnce()
+{
+    TripleBufferLatestValue<Sample> channel;
+
+    channel.Write(Sample{1, 2, 3});
+    channel.Write(Sample{4, 5, 6});
+
+    bool is_new = false;
+    TEST_ASSERT_EQUAL(4, channel.Read(is_new).x);
+    TEST_ASSERT_TRUE(is_new);
+    TEST_ASSERT_EQUAL(4, channel.Read(is_new).x);
+    TEST_ASSERT_FALSE(is_new);
+
+    // The writer may fill its buffer in place
+    channel.GetWriteBuffer().x = 7;
+    channel.Publish();
+    TEST_ASSERT_EQUAL(7, channel.Read(is_new).x);
+    TEST_ASSERT_TRUE(is_new);
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_SeqlockRead_AfterWrites_ReturnsLatestValueAndSequence);
+    RUN_TEST(test_TripleBufferRead_NewValue_FlaggedOnce);
+    return UnityEnd();
+}
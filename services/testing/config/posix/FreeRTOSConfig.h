@@ -99,7 +99,36 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay					1
 #define INCLUDE_uxTaskGetStackHighWaterMark 0 /* Do not use this option on the PC port. */
 #define INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
 
 #define configGENERATE_RUN_TIME_STATS		1
 
+/* Stacks of statically allocated tasks (djetk::StaticTask) are not taken from
+the heap, so they must not be returned to it when the task is deleted. */
+#ifdef __cplusplus
+extern "C"
+#endif
+void vApplicationFreeTaskStack( void *pvStack );
+#define vPortFreeAligned( pvBlockToFree ) vApplicationFreeTaskStack( pvBlockToFree )
+
+/* Run time accounting of djetk::FreeRTOSTaskBase tasks (see djetk::TaskStats).
+The tag of each task points to its counters. The hooks are defined along with
+FreeRTOSTaskBase, and freertos-default-hooks.c provides weak defaults for
+executables that link the kernel without it. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+void vApplicationTaskSwitchedIn( void *pvTaskTag, unsigned long ulTime );
+void vApplicationTaskSwitchedOut( void *pvTaskTag, unsigned long ulTime );
+void vApplicationTaskBlockingOnQueue( void *pvTaskTag, unsigned long ulTime );
+#ifdef __cplusplus
+}
+#endif
+#define traceTASK_SWITCHED_IN() \
+	vApplicationTaskSwitchedIn( ( void * ) pxCurrentTCB->pxTaskTag, portGET_RUN_TIME_COUNTER_VALUE() )
+#define traceTASK_SWITCHED_OUT() \
+	vApplicationTaskSwitchedOut( ( void * ) pxCurrentTCB->pxTaskTag, portGET_RUN_TIME_COUNTER_VALUE() )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) \
+	vApplicationTaskBlockingOnQueue( ( void * ) xTaskGetApplicationTaskTag( NULL ), portGET_RUN_TIME_COUNTER_VALUE() )
+
 #endif /* FREERTOS_CONFIG_H */
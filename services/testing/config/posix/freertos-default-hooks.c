@@ -0,0 +1,39 @@
+/*
+ * Default FreeRTOS application hooks
+ *
+ * FreeRTOSConfig.h routes kernel events to application hooks that djetk
+ * defines in the threads library (FreeRTOSScheduler, FreeRTOSTaskBase and
+ * TaskStats). These weak defaults are built into the kernel library so that
+ * executables linking the kernel without those classes still link. The
+ * definitions in threads take precedence whenever they are linked.
+ */
+
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+
+__attribute__((weak)) void vApplicationIdleHook( void )
+{
+}
+
+__attribute__((weak)) void vApplicationFreeTaskStack( void *pvStack )
+{
+	vPortFree( pvStack );
+}
+
+__attribute__((weak)) void vApplicationTaskSwitchedIn( void *pvTaskTag, unsigned long ulTime )
+{
+	( void ) pvTaskTag;
+	( void ) ulTime;
+}
+
+__attribute__((weak)) void vApplicationTaskSwitchedOut( void *pvTaskTag, unsigned long ulTime )
+{
+	( void ) pvTaskTag;
+	( void ) ulTime;
+}
+
+__attribute__((weak)) void vApplicationTaskBlockingOnQueue( void *pvTaskTag, unsigned long ulTime )
+{
+	( void ) pvTaskTag;
+	( void ) ulTime;
+}
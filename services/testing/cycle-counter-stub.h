@@ -0,0 +1,65 @@
+/**
+    \file
+    \brief Cycle counter stub
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CYCLE_COUNTER_STUB_H
+#define CYCLE_COUNTER_STUB_H
+
+#include <profiling/icycle-counter.h>
+
+namespace djetk {
+
+/**
+ * \brief Cycle counter stub for testing
+ *
+ * The count advances by \ref step every time it is read, so code measured
+ * between two reads appears to take \ref step cycles.
+ */
+class CycleCounterStub : public ICycleCounter {
+  public:
+    CycleCounterStub()
+        : cycles(0),
+        step(0)
+    {
+    }
+
+    virtual uint32_t GetCycles() override
+    {
+        auto current = cycles;
+        cycles += step;
+        return current;
+    }
+
+    /**
+     * \brief Value returned by the next read
+     */
+    uint32_t cycles;
+
+    /**
+     * \brief Increment applied after each read
+     */
+    uint32_t step;
+};
+
+}    // namespace djetk
+
+#endif    // CYCLE_COUNTER_STUB_H
@@ -34,7 +34,9 @@ namespace djetk {
 class MessageQueueStub : public IMessageQueue {
   public:
     MessageQueueStub()
-        : post_count(0) {}
+        : post_count(0),
+        receive_timeout_ms(0),
+        is_empty(false) {}
 
     virtual bool PostMessage(const Message &message, uint32_t timeout_ms) override
     {
@@ -54,7 +56,11 @@ class MessageQueueStub : public IMessageQueue {
 
     virtual bool ReceiveMessage(uint32_t timeout_ms, Message &message) override
     {
-        (void)timeout_ms;
+        receive_timeout_ms = timeout_ms;
+        if (is_empty) {
+            return false;
+        }
+
         message = msg_out;
         return true;
     }
@@ -80,6 +86,16 @@ class MessageQueueStub : public IMessageQueue {
      * \brief Number of messages posted
      */
     int post_count;
+
+    /**
+     * \brief Timeout of the last receive
+     */
+    uint32_t receive_timeout_ms;
+
+    /**
+     * \brief When set, receive functions fail as if the queue was empty
+     */
+    bool is_empty;
 };
 
 }    // namespace djetk
@@ -53,6 +53,23 @@ class OsServicesStub : public IOsServices {
      */
     virtual void EnableInterrupts() override {}
 
+    /**
+     * \brief See \ref IOsServices::MaskInterrupts
+     */
+    virtual uint32_t MaskInterrupts(uint32_t level) override
+    {
+        (void)level;
+        return 0;
+    }
+
+    /**
+     * \brief See \ref IOsServices::RestoreInterruptMask
+     */
+    virtual void RestoreInterruptMask(uint32_t previous) override
+    {
+        (void)previous;
+    }
+
     ~OsServicesStub() {}
 
   private:
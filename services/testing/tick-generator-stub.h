@@ -0,0 +1,94 @@
+/**
+    \file
+    \brief Tick source stub that notifies many clients
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TICK_GENERATOR_STUB_H
+#define TICK_GENERATOR_STUB_H
+
+#include <array>
+#include <cstddef>
+#include <timing/itick-source.h>
+
+namespace djetk {
+
+/**
+ * \brief Tick source stub for testing
+ *
+ * - Registered clients are notified in registration order when \ref Tick
+ *   is invoked
+ * - One millisecond converts to one tick
+ */
+class TickGeneratorStub : public ITickSource {
+  public:
+    TickGeneratorStub()
+        : client_count(0) {}
+
+    virtual bool RegisterTickClient(ITickClient &client) override
+    {
+        if (client_count == clients.size()) {
+            return false;
+        }
+
+        clients[client_count++] = &client;
+        return true;
+    }
+
+    virtual uint32_t MsToTicks(uint32_t milliseconds) override
+    {
+        return milliseconds;
+    }
+
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) override
+    {
+        return kernel_ticks;
+    }
+
+    /**
+     * \brief Generate a tick event
+     * \return The task_woken value accumulated over all the clients
+     */
+    bool Tick()
+    {
+        bool task_woken = false;
+        for (size_t i = 0; i < client_count; i++) {
+            bool client_task_woken = false;
+            clients[i]->OnTickFromIsr(client_task_woken);
+            task_woken = task_woken || client_task_woken;
+        }
+
+        return task_woken;
+    }
+
+    /**
+     * \brief Registered clients
+     */
+    std::array<ITickClient *, 8> clients;
+
+    /**
+     * \brief Number of registered clients
+     */
+    size_t client_count;
+};
+
+}    // namespace djetk
+
+#endif    // TICK_GENERATOR_STUB_H
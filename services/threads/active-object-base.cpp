@@ -0,0 +1,108 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+
+#include "threads/active-object-base.h"
+#include "timing/freertos-ticks.h"
+
+namespace djetk {
+
+ActiveObjectBase::ActiveObjectBase(size_t queue_depth, ICycleCounter &cycle_counter,
+        ICriticalErrorHandler &error_handler)
+    : cycle_counter_(cycle_counter),
+    rate_window_start_(0),
+    rate_window_count_(0),
+    message_rate_(0)
+{
+    queue_ = xQueueCreate(queue_depth, sizeof(Envelope));
+    if (queue_ == 0) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+    }
+}
+
+ActiveObjectBase::~ActiveObjectBase()
+{
+    vQueueDelete(queue_);
+}
+
+bool ActiveObjectBase::PostMessage(const Message &message, uint32_t timeout_ms)
+{
+    Envelope envelope = { message, cycle_counter_.GetCycles() };
+    if (xQueueSend(queue_, &envelope, ms_to_FreeRTOSTicks(timeout_ms)) != pdPASS) {
+        return false;
+    }
+
+    return true;
+}
+
+bool ActiveObjectBase::PostMessageFromIsr(const Message &message, bool &task_woken)
+{
+    Envelope envelope = { message, cycle_counter_.GetCycles() };
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+    if (xQueueSendFromISR(queue_, &envelope, &xHigherPriorityTaskWoken) == pdFALSE) {
+        return false;
+    }
+
+    // Other calls within the same ISR may have already woken a task
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        task_woken = true;
+    }
+
+    return true;
+}
+
+bool ActiveObjectBase::ReceiveMessage(uint32_t timeout_ms, Message &message)
+{
+    (void)timeout_ms;
+    (void)message;
+    return false;
+}
+
+bool ActiveObjectBase::ReceiveMessageFromIsr(Message &message, bool &task_woken)
+{
+    (void)message;
+    (void)task_woken;
+    return false;
+}
+
+bool ActiveObjectBase::Receive(Ticks timeout, Envelope &envelope)
+{
+    if (xQueueReceive(queue_, &envelope, timeout.Count()) != pdPASS) {
+        return false;
+    }
+
+    residency_.Record(cycle_counter_.GetCycles() - envelope.posted_cycles);
+    return true;
+}
+
+void ActiveObjectBase::RecordDispatch(uint32_t start_cycles)
+{
+    run_to_completion_.Record(cycle_counter_.GetCycles() - start_cycles);
+
+    UpdateMessageRate(xTaskGetTickCount(), 1);
+}
+
+uint32_t ActiveObjectBase::GetMessageRate()
+{
+    return UpdateMessageRate(xTaskGetTickCount(), 0);
+}
+
+uint32_t ActiveObjectBase::UpdateMessageRate(portTickType now, uint32_t messages)
+{
+    // The active object and the readers of the rate may run in different tasks
+    taskENTER_CRITICAL();
+    rate_window_count_ += messages;
+    auto elapsed = now - rate_window_start_;
+    if (elapsed >= configTICK_RATE_HZ) {
+        message_rate_ = static_cast<uint32_t>(
+                (static_cast<uint64_t>(rate_window_count_) * configTICK_RATE_HZ) / elapsed);
+        rate_window_count_ = 0;
+        rate_window_start_ = now;
+    }
+    auto rate = message_rate_;
+    taskEXIT_CRITICAL();
+
+    return rate;
+}
+
+}   // namespace
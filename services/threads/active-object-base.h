@@ -0,0 +1,140 @@
+#ifndef ACTIVE_OBJECT_BASE_H
+#define ACTIVE_OBJECT_BASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/queue.h>
+#include "messaging/imessage-queue.h"
+#include "timing/freertos-duration.h"
+#include "profiling/icycle-counter.h"
+#include "profiling/execution-stats.h"
+#include "errors/icritical-error-handler.h"
+
+namespace djetk {
+
+/**
+ * \brief Queue and metrics of an \ref ActiveObject
+ *
+ * The active object is the message queue of its component. Messages posted to
+ * it are stamped with the cycle count so that the time spent in the queue can
+ * be measured when they are dispatched. The following is recorded for every
+ * active object:
+ * - Run to completion time of the message handler (cycles)
+ * - Queue residency of the dispatched messages (cycles)
+ * - Rate of handled messages per second
+ */
+class ActiveObjectBase : public IMessageQueue {
+  public:
+    /**
+     * \brief Construct the queue of the active object
+     * \param[in]   queue_depth     Number of messages held by the queue
+     * \param[in]   cycle_counter   Clock used to measure the metrics
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    ActiveObjectBase(size_t queue_depth, ICycleCounter &cycle_counter,
+            ICriticalErrorHandler &error_handler);
+
+    /**
+     * \brief Delete the queue
+     */
+    virtual ~ActiveObjectBase();
+
+    virtual bool PostMessage(const Message &message, uint32_t timeout_ms) override;
+
+    virtual bool PostMessageFromIsr(const Message &message, bool &task_woken) override;
+
+    /**
+     * \brief Receiving is reserved to the active object, so this always fails
+     */
+    virtual bool ReceiveMessage(uint32_t timeout_ms, Message &message) override;
+
+    /**
+     * \brief Receiving is reserved to the active object, so this always fails
+     */
+    virtual bool ReceiveMessageFromIsr(Message &message, bool &task_woken) override;
+
+    /**
+     * \brief Get the run to completion statistics of the message handler
+     *
+     * A budget set on the returned object flags handlers that take too long.
+     */
+    ExecutionStats &GetRunToCompletionStats()
+    {
+        return run_to_completion_;
+    }
+
+    /**
+     * \brief Get the statistics of the time messages spent in the queue
+     */
+    ExecutionStats &GetResidencyStats()
+    {
+        return residency_;
+    }
+
+    /**
+     * \brief Get the number of messages handled per second
+     *
+     * The rate is averaged over windows of at least one second. A window
+     * closes on the first dispatch or read after it has lasted a second, so
+     * the rate drops to 0 once messages stop.
+     */
+    uint32_t GetMessageRate();
+
+  protected:
+    /**
+     * \brief Queued message along with the time it was posted
+     */
+    struct Envelope {
+        Message message;
+        uint32_t posted_cycles;
+    };
+
+    /**
+     * \brief Take the next message from the queue
+     * \param[in]   timeout     Time to wait for a message
+     * \param[out]  envelope    Received message
+     * \return false if timed out
+     *
+     * The queue residency of the message is recorded.
+     */
+    bool Receive(Ticks timeout, Envelope &envelope);
+
+    /**
+     * \brief Get the cycle count at the start of a dispatch
+     */
+    uint32_t GetCycles()
+    {
+        return cycle_counter_.GetCycles();
+    }
+
+    /**
+     * \brief Record the completion of a dispatch
+     * \param[in]   start_cycles    Cycle count when the dispatch started
+     */
+    void RecordDispatch(uint32_t start_cycles);
+
+    /**
+     * \brief Count handled messages and close the rate window once it lasted a second
+     * \param[in]   now         Current tick count
+     * \param[in]   messages    Number of messages handled since the last update
+     * \return The message rate (see \ref GetMessageRate)
+     */
+    uint32_t UpdateMessageRate(portTickType now, uint32_t messages);
+
+  private:
+    ActiveObjectBase(const ActiveObjectBase &rhs);
+    const ActiveObjectBase& operator=(const ActiveObjectBase &rhs);
+
+    xQueueHandle queue_;
+    ICycleCounter &cycle_counter_;
+    ExecutionStats run_to_completion_;
+    ExecutionStats residency_;
+    portTickType rate_window_start_;
+    uint32_t rate_window_count_;
+    uint32_t message_rate_;
+};
+
+}   // namespace
+
+#endif
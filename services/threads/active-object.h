@@ -0,0 +1,88 @@
+#ifndef ACTIVE_OBJECT_H
+#define ACTIVE_OBJECT_H
+
+#include <cstddef>
+#include "threads/active-object-base.h"
+#include "threads/freertos-static-task.h"
+
+namespace djetk {
+
+/**
+ * \brief Component with its own queue and task
+ * \param Derived       Component class. It must provide a non-virtual
+ *                      `bool HandleMessage(const Message &msg)` accessible to
+ *                      this class.
+ * \param QueueDepth    Number of messages held by the queue
+ * \param StackWords    Task stack depth in words
+ *
+ * This replaces the FreeRTOSQueue, QueueDispatcher, FreeRTOSQueueTask and
+ * IMessageHandler wiring of a component. Messages posted to the object are
+ * handled to completion, one at a time, by its task. The handler is invoked
+ * directly on the derived class rather than through IMessageHandler.
+ *
+ * The stack is part of the object (see \ref StaticTask). FreeRTOS 6.0.4
+ * allocates the queue storage from the heap.
+ *
+ * \code
+ * class Blinker : public ActiveObject<Blinker, 8, 200> {
+ *   public:
+ *     Blinker(ICriticalErrorHandler &error_handler, ICycleCounter &cycle_counter)
+ *         : ActiveObject(error_handler, cycle_counter,
+ *                 reinterpret_cast<const signed char *>("BLINK"), 2) {}
+ *
+ *     bool HandleMessage(const Message &msg);
+ * };
+ * \endcode
+ */
+template <class Derived, size_t QueueDepth, unsigned short StackWords>
+class ActiveObject : public ActiveObjectBase, private StaticTask<StackWords> {
+  public:
+    /**
+     * \brief Create the queue and task of the active object
+     * \param[in]   error_handler   Reference to application specific error handler
+     * \param[in]   cycle_counter   Clock used to measure the metrics
+     * \param[in]   name            Task name used by FreeRTOS
+     * \param[in]   priority        FreeRTOS task priority
+     *
+     * The queue is created before the task, so the task may start immediately.
+     */
+    ActiveObject(ICriticalErrorHandler &error_handler, ICycleCounter &cycle_counter,
+            const signed char *name, unsigned portBASE_TYPE priority)
+        : ActiveObjectBase(QueueDepth, cycle_counter, error_handler),
+        StaticTask<StackWords>(error_handler, name, priority)
+    {
+    }
+
+    /**
+     * \brief Handle the next queued message
+     * \param[in]   timeout     Time to wait for a message
+     * \return false if no message was received
+     */
+    bool Dispatch(Ticks timeout)
+    {
+        Envelope envelope;
+        if (!Receive(timeout, envelope)) {
+            return false;
+        }
+
+        auto start = GetCycles();
+        static_cast<Derived *>(this)->HandleMessage(envelope.message);
+        RecordDispatch(start);
+        return true;
+    }
+
+  private:
+    /**
+     * \brief See \ref FreeRTOSTaskBase::TaskMain
+     */
+    virtual void TaskMain() override
+    {
+        for (;;) {
+            Dispatch(Ticks::Infinite());
+        }
+    }
+};
+
+}   // namespace
+
+#endif
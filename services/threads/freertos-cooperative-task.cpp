@@ -0,0 +1,61 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+
+#include "threads/freertos-cooperative-task.h"
+
+namespace djetk {
+
+FreeRTOSSemaphoreSleeper::FreeRTOSSemaphoreSleeper(ICriticalErrorHandler &error_handler,
+        Ticks max_sleep)
+    : wake_(xSemaphoreCreateCounting(1, 0)),
+    max_sleep_(max_sleep)
+{
+    if (wake_ == nullptr) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+    }
+}
+
+FreeRTOSSemaphoreSleeper::~FreeRTOSSemaphoreSleeper()
+{
+    if (wake_ != nullptr) {
+        vQueueDelete(wake_);
+    }
+}
+
+void FreeRTOSSemaphoreSleeper::Sleep()
+{
+    xSemaphoreTake(wake_, max_sleep_.Count());
+}
+
+void FreeRTOSSemaphoreSleeper::Wake()
+{
+    // Fails harmlessly if a wake up is already pending
+    xSemaphoreGive(wake_);
+}
+
+void FreeRTOSSemaphoreSleeper::WakeFromIsr(bool &task_woken)
+{
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(wake_, &xHigherPriorityTaskWoken);
+
+    // Other calls within the same ISR may have already woken a task
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        task_woken = true;
+    }
+}
+
+FreeRTOSCooperativeTask::FreeRTOSCooperativeTask(ICriticalErrorHandler &error_handler,
+        const signed char *name, unsigned short stack_depth,
+        unsigned portBASE_TYPE priority, CooperativeExecutor &executor)
+    : FreeRTOSTaskBase(error_handler, name, stack_depth, priority),
+    executor_(executor)
+{
+}
+
+void FreeRTOSCooperativeTask::TaskMain()
+{
+    executor_.Run();
+}
+
+}   // namespace
@@ -0,0 +1,85 @@
+#ifndef FREERTOS_COOPERATIVE_TASK_H
+#define FREERTOS_COOPERATIVE_TASK_H
+
+#include <FreeRTOS/Source/include/semphr.h>
+#include "threads/freertos-task-base.h"
+#include "messaging/cooperative-executor.h"
+#include "timing/freertos-duration.h"
+
+namespace djetk {
+
+/**
+ * \brief Sleeps by blocking the calling FreeRTOS task on a semaphore
+ *
+ * The executor sleeps until a message is posted through a \ref WakingQueue
+ * (or \ref Wake is invoked), so an idle executor costs no context switches.
+ * A wake up that arrives while the executor is busy is latched, so the next
+ * sleep returns straight away.
+ *
+ * Coroutines waiting on a delay or a timeout need the executor to run as
+ * time passes. Give those executors a maximum sleep time no longer than the
+ * timeout resolution they need.
+ */
+class FreeRTOSSemaphoreSleeper : public IIdleSleeper {
+  public:
+    /**
+     * \brief Constructor
+     * \param[in]   error_handler   Callback reference to notify of errors
+     * \param[in]   max_sleep       Longest time to sleep for without a wake
+     *                              up (e.g. 10_ms), Ticks::Infinite() by default
+     */
+    explicit FreeRTOSSemaphoreSleeper(ICriticalErrorHandler &error_handler,
+            Ticks max_sleep = Ticks::Infinite());
+    ~FreeRTOSSemaphoreSleeper();
+
+    /**
+     * \brief See \ref IIdleSleeper::Sleep
+     */
+    virtual void Sleep() override;
+
+    /**
+     * \brief See \ref IIdleSleeper::Wake
+     */
+    virtual void Wake() override;
+
+    /**
+     * \brief See \ref IIdleSleeper::WakeFromIsr
+     */
+    virtual void WakeFromIsr(bool &task_woken) override;
+
+  private:
+    FreeRTOSSemaphoreSleeper(const FreeRTOSSemaphoreSleeper &rhs);
+    const FreeRTOSSemaphoreSleeper& operator=(const FreeRTOSSemaphoreSleeper &rhs);
+
+    xSemaphoreHandle wake_;
+    Ticks max_sleep_;
+};
+
+/**
+ * \brief FreeRTOS task that runs a \ref CooperativeExecutor
+ *
+ * All the dispatchers of the executor share this task's stack.
+ */
+class FreeRTOSCooperativeTask : public FreeRTOSTaskBase {
+  public:
+    /**
+     * \brief Task constructor
+     * \param[in]   error_handler   Reference to error handling interface
+     * \param[in]   name            Task name
+     * \param[in]   stack_depth     Task stack depth
+     * \param[in]   priority        Task priority
+     * \param[in]   executor        Executor to run
+     */
+    FreeRTOSCooperativeTask(ICriticalErrorHandler &error_handler, const signed char *name,
+            unsigned short stack_depth, unsigned portBASE_TYPE priority,
+            CooperativeExecutor &executor);
+
+  private:
+    virtual void TaskMain() override;
+
+    CooperativeExecutor &executor_;
+};
+
+}   // namespace
+
+#endif
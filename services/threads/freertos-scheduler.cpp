@@ -5,6 +5,15 @@
 
 namespace djetk {
 
+namespace {
+
+/**
+ * \brief Handler invoked from the FreeRTOS idle hook
+ */
+IIdleHandler *idle_handler = nullptr;
+
+}   // namespace
+
 FreeRTOSScheduler& FreeRTOSScheduler::GetScheduler() {
     static FreeRTOSScheduler scheduler;
     return scheduler;
@@ -24,9 +33,27 @@ void FreeRTOSScheduler::Stop()
     vTaskEndScheduler();
 }
 
+bool FreeRTOSScheduler::RegisterIdleHandler(IIdleHandler &handler)
+{
+    if (idle_handler != nullptr) {
+        return false;
+    }
+
+    idle_handler = &handler;
+    return true;
+}
+
+void FreeRTOSScheduler::UnregisterIdleHandler()
+{
+    idle_handler = nullptr;
+}
+
 }   // namespace
 
 extern "C" void vApplicationIdleHook()
 {
+    if (djetk::idle_handler != nullptr) {
+        djetk::idle_handler->OnIdle();
+    }
 }
 
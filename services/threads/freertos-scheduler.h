@@ -1,6 +1,9 @@
 #ifndef FREERTOS_SCHEDULER_H
 #define FREERTOS_SCHEDULER_H
 
+#include "os/iidle-handler.h"
+#include "threads/ischeduler.h"
+
 namespace djetk {
 
 /**
@@ -10,7 +13,7 @@ namespace djetk {
  * Uses the singleton pattern to limit the number of class instances
  * to 1.
  */
-class FreeRTOSScheduler {
+class FreeRTOSScheduler : public IScheduler {
  public:
     /**
      * \brief Get an instance to the scheduler
@@ -20,13 +23,28 @@ class FreeRTOSScheduler {
     /**
      * \brief Start the FreeRTOS scheduler
      */
-    void Start();
+    virtual void Start() override;
 
     /**
      * \brief Stop the FreeRTOS scheduler.
      * \note Support for this function depends on the selected port
      */
-    void Stop();
+    virtual void Stop() override;
+
+    /**
+     * \brief Register the handler invoked from the FreeRTOS idle hook
+     * \param[in]   handler Handler to register
+     * \return true if successful
+     *
+     * Only one idle handler is supported. Subsequent calls return false.
+     * Requires configUSE_IDLE_HOOK to be set to 1.
+     */
+    bool RegisterIdleHandler(IIdleHandler &handler);
+
+    /**
+     * \brief Unregister the idle handler
+     */
+    void UnregisterIdleHandler();
 
  private:
     /**
@@ -0,0 +1,81 @@
+#ifndef FREERTOS_STATIC_TASK_H
+#define FREERTOS_STATIC_TASK_H
+
+#include <array>
+#include "threads/freertos-task-base.h"
+
+/**
+ * \brief Place a statically allocated task in a named linker section
+ * \param name  Identifier of the task in the map file
+ *
+ * Prefix the definition of a namespace scope \ref djetk::StaticTask object
+ * with this to have its RAM reservation listed in the map file under
+ * .bss.djetk_task.<name>. tools/task-stack-report.py summarises these
+ * entries. For example:
+ *
+ *     DJETK_STATIC_TASK(producer) static ProducerTask producer(error_handler);
+ */
+#define DJETK_STATIC_TASK(name) __attribute__((section(".bss.djetk_task." #name)))
+
+namespace djetk {
+
+namespace detail {
+
+/**
+ * \brief Stack storage of a \ref StaticTask
+ *
+ * This is a separate base so that the storage exists before the task is
+ * created by \ref FreeRTOSTaskBase.
+ */
+template <unsigned short StackWords>
+class StaticTaskStack {
+  protected:
+    std::array<portSTACK_TYPE, StackWords> stack_;
+};
+
+}   // namespace detail
+
+/**
+ * \brief FreeRTOS task with a stack embedded in the object
+ * \param StackWords    Stack depth in words (portSTACK_TYPE)
+ *
+ * The stack size is fixed at compile time and the stack is allocated with the
+ * object, so statically defined tasks show up in the RAM usage reported by
+ * the linker. FreeRTOS 6.0.4 can't be given a task control block, so only the
+ * TCB is taken from the heap.
+ */
+template <unsigned short StackWords>
+class StaticTask : private detail::StaticTaskStack<StackWords>, public FreeRTOSTaskBase {
+  public:
+    static_assert(StackWords >= configMINIMAL_STACK_SIZE,
+            "Stack is smaller than the FreeRTOS minimum");
+
+    /**
+     * \brief Stack depth in words
+     */
+    static constexpr unsigned short kStackWords = StackWords;
+
+    /**
+     * \brief Stack size in bytes
+     */
+    static constexpr size_t kStackBytes = StackWords * sizeof(portSTACK_TYPE);
+
+    /**
+     * \brief Create a FreeRTOS task on the embedded stack
+     * \param[in]   error_handler   Reference to application specific error handler
+     * \param[in]   name            Task name used by FreeRTOS
+     * \param[in]   priority        FreeRTOS task priority
+     *
+     * See \ref FreeRTOSTaskBase::FreeRTOSTaskBase
+     */
+    StaticTask(ICriticalErrorHandler &error_handler, const signed char *name,
+            unsigned portBASE_TYPE priority)
+        : FreeRTOSTaskBase(error_handler, name, StackWords, priority,
+                this->stack_.data())
+    {
+    }
+};
+
+}   // namespace
+
+#endif
@@ -1,35 +1,286 @@
+#include <array>
+#include <cstdint>
 #include "threads/freertos-task-base.h"
+#include "threads/stack-paint.h"
+
+#if defined(portSTACK_GROWTH) && (portSTACK_GROWTH > 0)
+#error "Stack painting assumes the stack grows downwards"
+#endif
 
 namespace djetk {
 
+namespace {
+
+/**
+ * \brief Application supplied stacks that FreeRTOS must not free
+ */
+std::array<void *, FreeRTOSTaskBase::kMaxStaticStacks> static_stacks;
+
+/**
+ * \brief Run time counter value at the last context switch
+ */
+volatile uint32_t last_switch_time = 0;
+
+/**
+ * \brief Tag of the task switched out last
+ */
+void *last_switched_out = nullptr;
+
+}   // namespace
+
+FreeRTOSTaskBase *FreeRTOSTaskBase::first_task_ = nullptr;
+
 FreeRTOSTaskBase::FreeRTOSTaskBase(ICriticalErrorHandler &error_handler,
         const signed char *name, unsigned short stack_depth, unsigned portBASE_TYPE priority)
+    : handle_(nullptr),
+    name_(name),
+    stack_depth_(stack_depth),
+    stack_buffer_(nullptr),
+    painted_bottom_(nullptr),
+    painted_words_(0),
+    next_task_(nullptr)
+{
+    // Allocate the stack here rather than in FreeRTOS so that its bounds are
+    // known when painting. FreeStack returns it to the heap.
+    stack_buffer_ = static_cast<portSTACK_TYPE *>(
+            pvPortMalloc(stack_depth * sizeof(portSTACK_TYPE)));
+    if (stack_buffer_ == nullptr) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    auto rv = xTaskGenericCreate(TaskMainBase, name, stack_depth, this,
+                priority, &handle_, stack_buffer_, NULL);
+
+    // Critical Error Handler notifications don't return
+    if (rv != pdPASS) {
+        handle_ = nullptr;
+        vPortFree(stack_buffer_);
+        stack_buffer_ = nullptr;
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    Register();
+}
+
+FreeRTOSTaskBase::FreeRTOSTaskBase(ICriticalErrorHandler &error_handler,
+        const signed char *name, unsigned short stack_depth, unsigned portBASE_TYPE priority,
+        portSTACK_TYPE *stack_buffer)
+    : handle_(nullptr),
+    name_(name),
+    stack_depth_(stack_depth),
+    stack_buffer_(stack_buffer),
+    painted_bottom_(nullptr),
+    painted_words_(0),
+    next_task_(nullptr)
 {
-    auto rv = xTaskCreate(TaskMainBase, name, stack_depth, this,
-                priority, &handle_);
+    // Remember the stack so that it isn't handed to the heap on deletion
+    bool registered = false;
+    taskENTER_CRITICAL();
+    for (auto &stack : static_stacks) {
+        if (stack == nullptr) {
+            stack = stack_buffer;
+            registered = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (!registered) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    auto rv = xTaskGenericCreate(TaskMainBase, name, stack_depth, this,
+                priority, &handle_, stack_buffer, NULL);
 
     // Critical Error Handler notifications don't return
     if (rv != pdPASS) {
+        // Releases the slot
+        handle_ = nullptr;
+        FreeStack(stack_buffer);
         error_handler.NotifyCriticalError(ICriticalErrorHandler::freertos_error,
                __FILE__, __LINE__ );
+        return;
     }
+
+    Register();
 }
 
 FreeRTOSTaskBase::~FreeRTOSTaskBase()
 {
+    // The task was never created (nor registered)
+    if (handle_ == nullptr) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    for (auto link = &first_task_; *link != nullptr; link = &(*link)->next_task_) {
+        if (*link == this) {
+            *link = next_task_;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
     vTaskDelete(handle_);
 }
 
+void FreeRTOSTaskBase::Register()
+{
+    // The trace hooks find the counters of the running task through its tag
+    vTaskSetApplicationTaskTag(handle_, reinterpret_cast<pdTASK_HOOK_CODE>(&counters_));
+
+    taskENTER_CRITICAL();
+    next_task_ = first_task_;
+    first_task_ = this;
+    taskEXIT_CRITICAL();
+}
+
 void FreeRTOSTaskBase::Suspend()
 {
-    vTaskSuspend(handle_);
+    // A null handle would suspend the caller
+    if (handle_ != nullptr) {
+        vTaskSuspend(handle_);
+    }
+}
+
+void FreeRTOSTaskBase::Resume()
+{
+    if (handle_ != nullptr) {
+        vTaskResume(handle_);
+    }
+}
+
+void FreeRTOSTaskBase::FreeStack(void *stack)
+{
+    bool is_static = false;
+    taskENTER_CRITICAL();
+    for (auto &static_stack : static_stacks) {
+        if (static_stack == stack) {
+            static_stack = nullptr;
+            is_static = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (!is_static) {
+        vPortFree(stack);
+    }
+}
+
+uint32_t FreeRTOSTaskBase::GetLastSwitchTime()
+{
+    return last_switch_time;
+}
+
+size_t FreeRTOSTaskBase::GetStackUnusedWords() const
+{
+    if (painted_bottom_ == nullptr) {
+        return 0;
+    }
+
+    return StackPaint::CountUnused(painted_bottom_, painted_words_);
+}
+
+void FreeRTOSTaskBase::PaintStack()
+{
+    static constexpr size_t kWordSize = sizeof(portSTACK_TYPE);
+
+    // Nothing is called while filling, so the fill can't overwrite a live
+    // frame. The margin covers this frame and the red zone of leaf functions
+    // (128 bytes on x86-64).
+    portSTACK_TYPE marker;
+    auto here = reinterpret_cast<uintptr_t>(&marker) & ~static_cast<uintptr_t>(kWordSize - 1);
+    auto buffer_bottom = reinterpret_cast<uintptr_t>(stack_buffer_);
+    auto buffer_top = buffer_bottom + (stack_depth_ * kWordSize);
+
+    uintptr_t bottom;
+    if ((here >= buffer_bottom) && (here < buffer_top)) {
+        bottom = buffer_bottom;
+    } else {
+        // The port runs the task on a stack of its own (a thread on the POSIX
+        // port), which is large enough to paint the task's depth below this
+        // frame
+        if (stack_depth_ <= kStackEntryReserveWords) {
+            return;
+        }
+
+        bottom = here - ((kPaintMarginWords + stack_depth_ - kStackEntryReserveWords) * kWordSize);
+    }
+
+    auto top = here - (kPaintMarginWords * kWordSize);
+    if (top <= bottom) {
+        return;
+    }
+
+    auto end = reinterpret_cast<volatile portSTACK_TYPE *>(top);
+    for (auto word = reinterpret_cast<volatile portSTACK_TYPE *>(bottom); word < end; word++) {
+        *word = StackPaint::kPattern;
+    }
+
+    painted_words_ = (top - bottom) / kWordSize;
+    painted_bottom_ = reinterpret_cast<portSTACK_TYPE *>(bottom);
 }
 
 void FreeRTOSTaskBase::TaskMainBase(void *self)
 {
     auto self_ = static_cast<FreeRTOSTaskBase *>(self);
+    self_->PaintStack();
     self_->TaskMain();
 }
 
 }   // namespace
 
+
+extern "C" void vApplicationFreeTaskStack(void *stack)
+{
+    djetk::FreeRTOSTaskBase::FreeStack(stack);
+}
+
+extern "C" void vApplicationTaskSwitchedOut(void *pvTaskTag, unsigned long ulTime)
+{
+    auto counters = static_cast<djetk::TaskRunTimeCounters *>(pvTaskTag);
+    if (counters != nullptr) {
+        counters->run_time += static_cast<uint32_t>(ulTime) - counters->switched_in_at;
+    }
+
+    djetk::last_switched_out = pvTaskTag;
+}
+
+extern "C" void vApplicationTaskSwitchedIn(void *pvTaskTag, unsigned long ulTime)
+{
+    auto now = static_cast<uint32_t>(ulTime);
+    djetk::last_switch_time = now;
+
+    auto counters = static_cast<djetk::TaskRunTimeCounters *>(pvTaskTag);
+    if (counters == nullptr) {
+        return;
+    }
+
+    counters->switched_in_at = now;
+
+    // The kernel reselects the running task on every tick
+    if (pvTaskTag != djetk::last_switched_out) {
+        counters->switch_count++;
+    }
+
+    if (counters->blocked_on_queue) {
+        counters->queue_blocked_time += now - counters->blocked_at;
+        counters->blocked_on_queue = false;
+    }
+}
+
+extern "C" void vApplicationTaskBlockingOnQueue(void *pvTaskTag, unsigned long ulTime)
+{
+    auto counters = static_cast<djetk::TaskRunTimeCounters *>(pvTaskTag);
+    if (counters != nullptr) {
+        counters->blocked_on_queue = true;
+        counters->blocked_at = static_cast<uint32_t>(ulTime);
+    }
+}
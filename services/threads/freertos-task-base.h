@@ -1,18 +1,58 @@
 #ifndef FREERTOS_TASK_BASE_H
 #define FREERTOS_TASK_BASE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <FreeRTOS/Source/include/FreeRTOS.h>
 #include <FreeRTOS/Source/include/task.h>
 #include "errors/icritical-error-handler.h"
+#include "threads/itask.h"
 
 namespace djetk {
 
+/**
+ * \brief Run time counters of a task
+ *
+ * The counters are updated by the FreeRTOS trace hooks (see FreeRTOSConfig.h)
+ * and are in units of the run time stats counter. They wrap around at 32 bits.
+ */
+struct TaskRunTimeCounters {
+    TaskRunTimeCounters()
+        : run_time(0), switch_count(0), queue_blocked_time(0),
+        switched_in_at(0), blocked_at(0), blocked_on_queue(false),
+        sampled_run_time(0), cpu_percent(0) {}
+
+    /**
+     * \brief Time spent running
+     */
+    uint32_t run_time;
+
+    /**
+     * \brief Number of times the task was switched in after another task ran
+     */
+    uint32_t switch_count;
+
+    /**
+     * \brief Time from blocking on a queue receive until running again
+     */
+    uint32_t queue_blocked_time;
+
+    /**
+     * \privatesection Bookkeeping of the trace hooks and \ref TaskStats
+     */
+    uint32_t switched_in_at;
+    uint32_t blocked_at;
+    bool blocked_on_queue;
+    uint32_t sampled_run_time;
+    uint32_t cpu_percent;
+};
+
 /**
  * \brief FreeRTOS Task base class
  *
  * All application specific threads can be derived from this.
  */
-class FreeRTOSTaskBase {
+class FreeRTOSTaskBase : public ITask {
   public:
     /**
      * \brief Create a FreeRTOS task object
@@ -41,9 +81,143 @@ class FreeRTOSTaskBase {
     virtual ~FreeRTOSTaskBase();
 
     /**
-     * \brief Suspend the task
+     * \brief Check whether the FreeRTOS task was created
+     *
+     * Creation fails when the stack, the task control block or a slot for an
+     * application supplied stack can't be allocated. The failure is notified
+     * to the error handler and the object is left inert.
+     */
+    bool IsCreated() const
+    {
+        return handle_ != nullptr;
+    }
+
+    /**
+     * \brief See \ref ITask::Suspend
+     */
+    virtual void Suspend() override;
+
+    /**
+     * \brief See \ref ITask::Resume
+     */
+    virtual void Resume() override;
+
+    /**
+     * \brief Maximum number of tasks with application supplied stacks that
+     *        may exist (or await clean up by the idle task) at any time
+     */
+    static constexpr size_t kMaxStaticStacks = 16;
+
+    /**
+     * \brief Release a task stack on behalf of FreeRTOS
+     * \param[in]   stack   Stack of the deleted task
+     *
+     * FreeRTOS frees the stack of a deleted task from the idle task. Stacks
+     * supplied by the application (see \ref StaticTask) are not returned to
+     * the heap. This is invoked through vPortFreeAligned (see FreeRTOSConfig.h)
+     */
+    static void FreeStack(void *stack);
+
+    /**
+     * \brief Get the task name
+     */
+    const signed char *GetName() const
+    {
+        return name_;
+    }
+
+    /**
+     * \brief Get the run time counters of the task
+     */
+    const TaskRunTimeCounters &GetRunTimeCounters() const
+    {
+        return counters_;
+    }
+
+    /**
+     * \brief Get the stack depth in words
      */
-    void Suspend();
+    unsigned short GetStackDepth() const
+    {
+        return stack_depth_;
+    }
+
+    /**
+     * \brief Get the number of stack words that were never used
+     * \return 0 if the task hasn't started yet
+     *
+     * The task paints its stack from the bottom of its stack buffer up to
+     * \ref kPaintMarginWords below its entry frame when it starts. Ports
+     * that run tasks on stacks of their own (threads on the POSIX port) have
+     * the depth less \ref kStackEntryReserveWords painted below the entry
+     * frame instead, so the actual stack of the task is measured. The POSIX
+     * port also runs its signal handlers on that stack, so their frames add
+     * to the usage measured on the host, which only approximates the usage
+     * on a target.
+     */
+    size_t GetStackUnusedWords() const;
+
+    /**
+     * \brief Check whether the task has started and painted its stack
+     */
+    bool IsStackPainted() const
+    {
+        return painted_bottom_ != nullptr;
+    }
+
+    /**
+     * \brief Number of words assumed to be in use when the task starts
+     *
+     * This covers the initial context and the frames of the task entry, on
+     * ports that don't run the task on its stack buffer.
+     */
+    static constexpr size_t kStackEntryReserveWords = 32;
+
+    /**
+     * \brief Number of words left unpainted below the frame that paints
+     */
+    static constexpr size_t kPaintMarginWords = 32;
+
+    /**
+     * \brief Get the run time counter value at the last context switch
+     */
+    static uint32_t GetLastSwitchTime();
+
+    /**
+     * \brief Get the most recently created task that still exists
+     * \return nullptr if there are no tasks
+     *
+     * Tasks must not be created or destroyed while the list is traversed.
+     */
+    static FreeRTOSTaskBase *GetFirstTask()
+    {
+        return first_task_;
+    }
+
+    /**
+     * \brief Get the next (older) task in the list of tasks
+     * \return nullptr at the end of the list
+     */
+    FreeRTOSTaskBase *GetNextTask() const
+    {
+        return next_task_;
+    }
+
+  protected:
+    /**
+     * \brief Create a FreeRTOS task object on an application supplied stack
+     * \param[in]   error_handler   Reference to application specific error handler
+     * \param[in]   name            Task name used by FreeRTOS
+     * \param[in]   stack_depth     Stack depth in words of stack_buffer
+     * \param[in]   priority        FreeRTOS task priority
+     * \param[in]   stack_buffer    Memory to use as the task stack
+     *
+     * Only the task control block is allocated from the heap. The stack
+     * buffer must remain valid until the task is deleted.
+     */
+    FreeRTOSTaskBase(ICriticalErrorHandler &error_handler, const signed char *name,
+            unsigned short stack_depth, unsigned portBASE_TYPE priority,
+            portSTACK_TYPE *stack_buffer);
 
   private:
     /**
@@ -59,10 +233,31 @@ class FreeRTOSTaskBase {
      */
     static void TaskMainBase(void *self);
 
+    /**
+     * \brief Tag the created task with its counters and add it to the task list
+     */
+    void Register();
+
+    /**
+     * \brief Paint the unused part of the stack of the running task
+     */
+    void PaintStack();
+
+    friend class TaskStats;
+
     /**
      * \brief Handle to the freeRTOS task
      */
     xTaskHandle handle_;
+
+    const signed char *name_;
+    unsigned short stack_depth_;
+    portSTACK_TYPE *stack_buffer_;
+    portSTACK_TYPE *painted_bottom_;
+    size_t painted_words_;
+    TaskRunTimeCounters counters_;
+    FreeRTOSTaskBase *next_task_;
+    static FreeRTOSTaskBase *first_task_;
 };
 
 }   // namespace
@@ -0,0 +1,28 @@
+#ifndef ISCHEDULER_H
+#define ISCHEDULER_H
+
+namespace djetk {
+
+/**
+ * \brief Interface to the scheduler that runs the tasks
+ */
+class IScheduler {
+  public:
+    /**
+     * \brief Start running the tasks
+     *
+     * Doesn't return until \ref Stop is invoked.
+     */
+    virtual void Start() = 0;
+
+    /**
+     * \brief Stop running the tasks and return from \ref Start
+     */
+    virtual void Stop() = 0;
+
+    virtual ~IScheduler() {}
+};
+
+}   // namespace
+
+#endif
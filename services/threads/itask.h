@@ -0,0 +1,30 @@
+#ifndef ITASK_H
+#define ITASK_H
+
+namespace djetk {
+
+/**
+ * \brief Interface to a task created by an \ref IScheduler implementation
+ *
+ * Tasks are created by constructing an implementation specific task object
+ * (e.g. \ref FreeRTOSTaskBase or \ref NativeTaskBase) that runs the
+ * TaskMain of the derived class.
+ */
+class ITask {
+  public:
+    /**
+     * \brief Suspend the task until it is resumed
+     */
+    virtual void Suspend() = 0;
+
+    /**
+     * \brief Resume a suspended task
+     */
+    virtual void Resume() = 0;
+
+    virtual ~ITask() {}
+};
+
+}   // namespace
+
+#endif
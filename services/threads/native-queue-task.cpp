@@ -0,0 +1,20 @@
+#include "threads/native-queue-task.h"
+
+namespace djetk {
+
+NativeQueueTask::NativeQueueTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+        const char *name, unsigned int priority, IMessageDispatcher &message_dispatcher, int cpu)
+    : NativeTaskBase(scheduler, error_handler, name, priority, cpu),
+    message_dispatcher_(message_dispatcher)
+{
+}
+
+void NativeQueueTask::TaskMain()
+{
+    for(;;) {
+        // The dispatcher takes care of waiting and acting on events
+        message_dispatcher_.Poll();
+    }
+}
+
+}   // namespace
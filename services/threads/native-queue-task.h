@@ -0,0 +1,43 @@
+#ifndef NATIVE_QUEUE_TASK_H
+#define NATIVE_QUEUE_TASK_H
+
+#include "threads/native-task-base.h"
+#include "messaging/imessage-dispatcher.h"
+
+namespace djetk {
+
+/**
+ * \brief Native task that polls a \ref IMessageDispatcher
+ *
+ * The host counterpart of \ref FreeRTOSQueueTask. Pair it with a dispatcher
+ * of a \ref NativeQueue, whose blocking receive is where \ref Stop cancels
+ * the task.
+ *
+ * - Continually polls the injected message dispatcher
+ * - Like all native tasks, it must be started once constructed and stopped
+ *   before it is destroyed (see \ref NativeTaskBase)
+ */
+class NativeQueueTask : public NativeTaskBase {
+  public:
+    /**
+     * \brief Task constructor
+     * \param[in]   scheduler           Scheduler that releases the task
+     * \param[in]   error_handler       Reference to error handling interface
+     * \param[in]   name                Task name
+     * \param[in]   priority            Task priority
+     * \param[in]   message_dispatcher  Reference to message dispatcher to poll
+     * \param[in]   cpu                 CPU to pin the task to or \ref kAnyCpu
+     */
+    NativeQueueTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            const char *name, unsigned int priority, IMessageDispatcher &message_dispatcher,
+            int cpu = kAnyCpu);
+
+  private:
+    virtual void TaskMain() override;
+
+    IMessageDispatcher &message_dispatcher_;
+};
+
+}   // namespace
+
+#endif
@@ -0,0 +1,68 @@
+#include <unistd.h>
+#include "threads/native-scheduler.h"
+
+namespace djetk {
+
+namespace {
+
+/**
+ * \brief Cancellation clean up handler that releases a mutex
+ */
+void UnlockMutex(void *mutex)
+{
+    pthread_mutex_unlock(static_cast<pthread_mutex_t *>(mutex));
+}
+
+}   // namespace
+
+NativeScheduler::NativeScheduler()
+    : running_(false)
+{
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&changed_, nullptr);
+}
+
+NativeScheduler::~NativeScheduler()
+{
+    pthread_cond_destroy(&changed_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void NativeScheduler::Start()
+{
+    pthread_mutex_lock(&mutex_);
+    running_ = true;
+    pthread_cond_broadcast(&changed_);
+    while (running_) {
+        pthread_cond_wait(&changed_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+void NativeScheduler::Stop()
+{
+    pthread_mutex_lock(&mutex_);
+    running_ = false;
+    pthread_cond_broadcast(&changed_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+void NativeScheduler::WaitUntilStarted()
+{
+    // Tasks are cancelled while they wait here if they are destroyed before
+    // the scheduler starts
+    pthread_mutex_lock(&mutex_);
+    pthread_cleanup_push(UnlockMutex, &mutex_);
+    while (!running_) {
+        pthread_cond_wait(&changed_, &mutex_);
+    }
+    pthread_cleanup_pop(1);
+}
+
+size_t NativeScheduler::GetCpuCount()
+{
+    auto count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? static_cast<size_t>(count) : 1;
+}
+
+}   // namespace
@@ -0,0 +1,63 @@
+#ifndef NATIVE_SCHEDULER_H
+#define NATIVE_SCHEDULER_H
+
+#include <cstddef>
+#include <pthread.h>
+#include "threads/ischeduler.h"
+
+namespace djetk {
+
+/**
+ * \brief Scheduler for tasks that run as native POSIX threads
+ *
+ * Host builds use this to run tasks on every core, as opposed to the FreeRTOS
+ * POSIX simulator which runs one task at a time. Unlike \ref FreeRTOSScheduler
+ * there may be several instances, and each may be started and stopped any
+ * number of times.
+ *
+ * - Tasks (see \ref NativeTaskBase) wait for their scheduler to start before
+ *   they run their TaskMain
+ * - Stopping the scheduler returns from \ref Start but doesn't stop tasks
+ *   that are already running. They run until they are stopped (see
+ *   \ref NativeTaskBase::Stop).
+ */
+class NativeScheduler : public IScheduler {
+  public:
+    NativeScheduler();
+
+    virtual ~NativeScheduler();
+
+    /**
+     * \brief Release the tasks and block until \ref Stop is invoked
+     */
+    virtual void Start() override;
+
+    /**
+     * \brief Return from \ref Start
+     *
+     * May be invoked from any task or thread.
+     */
+    virtual void Stop() override;
+
+    /**
+     * \brief Block the calling thread until the scheduler is started
+     */
+    void WaitUntilStarted();
+
+    /**
+     * \brief Get the number of CPUs available to run tasks on
+     */
+    static size_t GetCpuCount();
+
+  private:
+    NativeScheduler(const NativeScheduler &rhs);
+    const NativeScheduler& operator=(const NativeScheduler &rhs);
+
+    pthread_mutex_t mutex_;
+    pthread_cond_t changed_;
+    bool running_;
+};
+
+}   // namespace
+
+#endif
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sched.h>
+#include "threads/native-task-base.h"
+
+namespace djetk {
+
+namespace {
+
+/**
+ * \brief Cancellation clean up handler that releases a mutex
+ */
+void UnlockMutex(void *mutex)
+{
+    pthread_mutex_unlock(static_cast<pthread_mutex_t *>(mutex));
+}
+
+/**
+ * \brief Longest thread name supported by pthread_setname_np
+ */
+constexpr size_t kMaxThreadName = 15;
+
+}   // namespace
+
+NativeTaskBase::NativeTaskBase(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+        const char *name, unsigned int priority, int cpu, size_t stack_bytes)
+    : scheduler_(scheduler),
+    error_handler_(error_handler),
+    name_(name),
+    priority_(priority),
+    cpu_(cpu),
+    stack_bytes_(stack_bytes),
+    created_(false),
+    real_time_(true),
+    suspended_(false)
+{
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&resumed_, nullptr);
+}
+
+NativeTaskBase::~NativeTaskBase()
+{
+    if (created_) {
+        // The derived object is gone while TaskMain may still be using it
+        error_handler_.NotifyCriticalError(ICriticalErrorHandler::os_error,
+               __FILE__, __LINE__ );
+        Stop();
+    }
+
+    pthread_cond_destroy(&resumed_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void NativeTaskBase::Start()
+{
+    if (created_) {
+        error_handler_.NotifyCriticalError(ICriticalErrorHandler::os_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (stack_bytes_ != 0) {
+        pthread_attr_setstacksize(&attr, stack_bytes_);
+    }
+
+    if (cpu_ != kAnyCpu) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu_, &cpus);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+
+    sched_param param;
+    param.sched_priority = MapPriority(priority_);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+
+    // Hold the task back until thread_ is set
+    pthread_mutex_lock(&mutex_);
+    real_time_ = true;
+    auto rv = pthread_create(&thread_, &attr, TaskMainBase, this);
+    if (rv == EPERM) {
+        // Not allowed to use real time priorities, so fall back to the
+        // default policy
+        real_time_ = false;
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        rv = pthread_create(&thread_, &attr, TaskMainBase, this);
+    }
+    pthread_attr_destroy(&attr);
+    pthread_mutex_unlock(&mutex_);
+
+    // Critical Error Handler notifications don't return
+    if (rv != 0) {
+        error_handler_.NotifyCriticalError(ICriticalErrorHandler::os_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    created_ = true;
+
+    char thread_name[kMaxThreadName + 1];
+    strncpy(thread_name, name_, kMaxThreadName);
+    thread_name[kMaxThreadName] = '\0';
+    pthread_setname_np(thread_, thread_name);
+}
+
+void NativeTaskBase::Stop()
+{
+    if (!created_) {
+        return;
+    }
+
+    pthread_cancel(thread_);
+    pthread_join(thread_, nullptr);
+    created_ = false;
+    suspended_ = false;
+}
+
+void NativeTaskBase::Suspend()
+{
+    if (!pthread_equal(pthread_self(), thread_)) {
+        error_handler_.NotifyCriticalError(ICriticalErrorHandler::os_error,
+               __FILE__, __LINE__ );
+        return;
+    }
+
+    pthread_mutex_lock(&mutex_);
+    pthread_cleanup_push(UnlockMutex, &mutex_);
+    suspended_ = true;
+    while (suspended_) {
+        pthread_cond_wait(&resumed_, &mutex_);
+    }
+    pthread_cleanup_pop(1);
+}
+
+void NativeTaskBase::Resume()
+{
+    pthread_mutex_lock(&mutex_);
+    suspended_ = false;
+    pthread_cond_signal(&resumed_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+int NativeTaskBase::MapPriority(unsigned int priority)
+{
+    auto lowest = sched_get_priority_min(SCHED_FIFO);
+    auto highest = sched_get_priority_max(SCHED_FIFO);
+    return std::min(static_cast<unsigned int>(highest - lowest), priority) + lowest;
+}
+
+void *NativeTaskBase::TaskMainBase(void *self)
+{
+    auto task = static_cast<NativeTaskBase *>(self);
+    pthread_mutex_lock(&task->mutex_);
+    pthread_mutex_unlock(&task->mutex_);
+
+    task->scheduler_.WaitUntilStarted();
+    task->TaskMain();
+    return nullptr;
+}
+
+}   // namespace
@@ -0,0 +1,149 @@
+#ifndef NATIVE_TASK_BASE_H
+#define NATIVE_TASK_BASE_H
+
+#include <cstddef>
+#include <pthread.h>
+#include "errors/icritical-error-handler.h"
+#include "threads/itask.h"
+#include "threads/native-scheduler.h"
+
+namespace djetk {
+
+/**
+ * \brief Task that runs as a native POSIX thread
+ *
+ * The host counterpart of \ref FreeRTOSTaskBase. The thread is created by
+ * \ref Start and runs TaskMain once the scheduler is started.
+ *
+ * - Priorities count up from 0 like FreeRTOS priorities. They map onto
+ *   SCHED_FIFO priorities when the process may use real time scheduling.
+ *   Otherwise the thread is created with the default policy and the
+ *   priority is ignored (see \ref IsRealTime).
+ * - The thread may be pinned to a CPU (see \ref NativeScheduler::GetCpuCount)
+ * - The thread runs in parallel with its owner, so it must only be started
+ *   once the derived object is fully constructed, and stopped before the
+ *   derived object is destroyed. The owner (or the most derived class)
+ *   invokes \ref Start and \ref Stop.
+ * - \ref Stop cancels the thread and waits for it to exit. TaskMain must
+ *   therefore reach a cancellation point (e.g. a blocking call) regularly.
+ *   Unlike FreeRTOS tasks, TaskMain may return.
+ * - Only the task itself may \ref Suspend. Other threads \ref Resume it.
+ */
+class NativeTaskBase : public ITask {
+  public:
+    /**
+     * \brief Value of the cpu parameter to let the task run on any CPU
+     */
+    static constexpr int kAnyCpu = -1;
+
+    /**
+     * \brief Construct the task without creating its thread
+     * \param[in]   scheduler       Scheduler that releases the task
+     * \param[in]   error_handler   Reference to application specific error handler
+     * \param[in]   name            Task name, truncated to 15 characters
+     * \param[in]   priority        Task priority, 0 being the lowest
+     * \param[in]   cpu             CPU to pin the task to or \ref kAnyCpu
+     * \param[in]   stack_bytes     Thread stack size, 0 for the default
+     */
+    NativeTaskBase(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            const char *name, unsigned int priority, int cpu = kAnyCpu,
+            size_t stack_bytes = 0);
+
+    /**
+     * \brief Destructor
+     *
+     * The task must be stopped first. A task that is still running is
+     * reported to the error handler before it is stopped.
+     */
+    virtual ~NativeTaskBase();
+
+    /**
+     * \brief Create the task thread
+     *
+     * TaskMain runs once the scheduler is started, or straight away if it
+     * is running already. Starting a task twice, or failing to create the
+     * thread, is notified via the injected error handler.
+     */
+    void Start();
+
+    /**
+     * \brief Cancel the thread and wait for it to exit
+     *
+     * Does nothing if the task isn't running. Must not be invoked by the
+     * task itself.
+     */
+    void Stop();
+
+    /**
+     * \brief Check whether the task thread exists
+     */
+    bool IsStarted() const
+    {
+        return created_;
+    }
+
+    /**
+     * \brief See \ref ITask::Suspend
+     */
+    virtual void Suspend() override;
+
+    /**
+     * \brief See \ref ITask::Resume
+     */
+    virtual void Resume() override;
+
+    /**
+     * \brief Get the task name
+     */
+    const char *GetName() const
+    {
+        return name_;
+    }
+
+    /**
+     * \brief Check whether the task runs with a real time priority
+     */
+    bool IsRealTime() const
+    {
+        return real_time_;
+    }
+
+    /**
+     * \brief Map a task priority onto a SCHED_FIFO priority
+     * \param[in]   priority    Task priority, 0 being the lowest
+     * \return SCHED_FIFO priority, saturated at the highest one
+     */
+    static int MapPriority(unsigned int priority);
+
+  private:
+    NativeTaskBase(const NativeTaskBase &rhs);
+    const NativeTaskBase& operator=(const NativeTaskBase &rhs);
+
+    /**
+     * \brief User defined Task main function
+     */
+    virtual void TaskMain() = 0;
+
+    /**
+     * \brief Thread entry function.
+     * \param[in]   self    Pointer to the object that owns the task.
+     */
+    static void *TaskMainBase(void *self);
+
+    NativeScheduler &scheduler_;
+    ICriticalErrorHandler &error_handler_;
+    const char *name_;
+    unsigned int priority_;
+    int cpu_;
+    size_t stack_bytes_;
+    pthread_t thread_;
+    bool created_;
+    bool real_time_;
+    pthread_mutex_t mutex_;
+    pthread_cond_t resumed_;
+    bool suspended_;
+};
+
+}   // namespace
+
+#endif
@@ -0,0 +1,41 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+
+#include "threads/stack-monitor.h"
+
+namespace djetk {
+
+StackMonitor::StackMonitor(uint32_t required_margin_percent)
+    : required_margin_percent_(required_margin_percent)
+{
+}
+
+size_t StackMonitor::GetStackInfo(StackInfoList &info) const
+{
+    size_t count = 0;
+
+    vTaskSuspendAll();
+    for (auto task = FreeRTOSTaskBase::GetFirstTask();
+            (task != nullptr) && (count < info.size()); task = task->GetNextTask()) {
+        if (!task->IsStackPainted()) {
+            continue;
+        }
+
+        uint32_t depth = task->GetStackDepth();
+        uint32_t unused = task->GetStackUnusedWords();
+
+        auto &entry = info.data()[count++];
+        entry.name = task->GetName();
+        entry.depth = depth;
+        entry.peak_used = depth - unused;
+        entry.margin_percent = (unused * 100) / depth;
+        entry.recommended_depth = entry.peak_used +
+            ((entry.peak_used * required_margin_percent_) + 99) / 100;
+        entry.below_margin = (depth < entry.recommended_depth);
+    }
+    xTaskResumeAll();
+
+    return count;
+}
+
+}   // namespace
@@ -0,0 +1,83 @@
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utilities/buffptr.h>
+#include "threads/freertos-task-base.h"
+
+namespace djetk {
+
+/**
+ * \brief Stack usage report of the tasks created through \ref FreeRTOSTaskBase
+ *
+ * Reports the peak usage of each task's stack (see
+ * \ref FreeRTOSTaskBase::GetStackUnusedWords) against its configured depth,
+ * along with the depth that would keep the required safety margin. Run the
+ * application through its worst case scenarios before using the recommended
+ * depths to right-size the stacks. Take them from a target build, as the
+ * usage measured on the POSIX port includes the port's signal handlers.
+ */
+class StackMonitor {
+  public:
+    /**
+     * \brief Stack usage of a single task. Sizes are in words.
+     */
+    struct StackInfo {
+        /**
+         * \brief Task name
+         */
+        const signed char *name;
+
+        /**
+         * \brief Configured stack depth
+         */
+        uint32_t depth;
+
+        /**
+         * \brief Deepest stack usage measured
+         */
+        uint32_t peak_used;
+
+        /**
+         * \brief Unused share of the configured depth
+         */
+        uint32_t margin_percent;
+
+        /**
+         * \brief Depth that gives the peak usage the required margin
+         */
+        uint32_t recommended_depth;
+
+        /**
+         * \brief Set if the margin is below the required margin
+         */
+        bool below_margin;
+    };
+
+    /**
+     * \brief Buffer pointer to a list (array) of stack usage information
+     */
+    typedef buffptr<StackInfo> StackInfoList;
+
+    /**
+     * \brief Constructor
+     * \param[in]   required_margin_percent Safety margin to keep above the
+     *              peak usage, as a percentage of the peak usage
+     */
+    explicit StackMonitor(uint32_t required_margin_percent = 25);
+
+    /**
+     * \brief Get the stack usage of each task that has started
+     * \param[out]  info    Buffer to write the stack usage to
+     * \return Number of tasks written. Tasks that don't fit are left out.
+     */
+    size_t GetStackInfo(StackInfoList &info) const;
+
+  private:
+    uint32_t required_margin_percent_;
+};
+
+}   // namespace
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef STACK_PAINT_H
+#define STACK_PAINT_H
+
+#include <cstddef>
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+
+namespace djetk {
+
+/**
+ * \brief Stack painting helpers
+ *
+ * A stack region is filled with a known pattern before use. The deepest
+ * point the stack has reached is then found by looking for the first word
+ * that no longer holds the pattern. Stacks are assumed to grow downwards.
+ */
+class StackPaint {
+  public:
+    /**
+     * \brief Pattern written to unused stack words
+     */
+    static constexpr portSTACK_TYPE kPattern =
+        static_cast<portSTACK_TYPE>(0xa5a5a5a5a5a5a5a5ULL);
+
+    /**
+     * \brief Fill a stack region with the pattern
+     * \param[in]   bottom  Lowest address of the region
+     * \param[in]   words   Size of the region in words
+     */
+    static void Paint(portSTACK_TYPE *bottom, size_t words)
+    {
+        volatile portSTACK_TYPE *word = bottom;
+        for (size_t i = 0; i < words; i++) {
+            word[i] = kPattern;
+        }
+    }
+
+    /**
+     * \brief Count the words that were never used
+     * \param[in]   bottom  Lowest address of a painted region
+     * \param[in]   words   Size of the region in words
+     * \return Number of words from the bottom that still hold the pattern
+     */
+    static size_t CountUnused(const portSTACK_TYPE *bottom, size_t words)
+    {
+        const volatile portSTACK_TYPE *word = bottom;
+        size_t unused = 0;
+        while ((unused < words) && (word[unused] == kPattern)) {
+            unused++;
+        }
+
+        return unused;
+    }
+};
+
+}   // namespace
+
+#endif
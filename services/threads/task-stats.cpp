@@ -0,0 +1,55 @@
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+
+#include "threads/task-stats.h"
+
+namespace djetk {
+
+TaskStats::TaskStats()
+    : last_sample_time_(FreeRTOSTaskBase::GetLastSwitchTime()),
+    window_(0)
+{
+}
+
+void TaskStats::Sample()
+{
+    // Stop context switches (and hence the trace hooks) while sampling
+    vTaskSuspendAll();
+
+    uint32_t now = FreeRTOSTaskBase::GetLastSwitchTime();
+    window_ = now - last_sample_time_;
+    last_sample_time_ = now;
+
+    for (auto task = FreeRTOSTaskBase::GetFirstTask(); task != nullptr;
+            task = task->GetNextTask()) {
+        auto &counters = task->counters_;
+        auto run_time = counters.run_time - counters.sampled_run_time;
+        counters.sampled_run_time = counters.run_time;
+        counters.cpu_percent = (window_ == 0) ? 0 :
+            static_cast<uint32_t>((static_cast<uint64_t>(run_time) * 100) / window_);
+    }
+
+    xTaskResumeAll();
+}
+
+size_t TaskStats::GetTaskInfo(TaskInfoList &info) const
+{
+    size_t count = 0;
+
+    vTaskSuspendAll();
+    for (auto task = FreeRTOSTaskBase::GetFirstTask();
+            (task != nullptr) && (count < info.size()); task = task->GetNextTask()) {
+        auto &counters = task->GetRunTimeCounters();
+        auto &entry = info.data()[count++];
+        entry.name = task->GetName();
+        entry.run_time = counters.run_time;
+        entry.cpu_percent = counters.cpu_percent;
+        entry.switch_count = counters.switch_count;
+        entry.queue_blocked_time = counters.queue_blocked_time;
+    }
+    xTaskResumeAll();
+
+    return count;
+}
+
+}   // namespace
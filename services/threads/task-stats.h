@@ -0,0 +1,90 @@
+#ifndef TASK_STATS_H
+#define TASK_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utilities/buffptr.h>
+#include "threads/freertos-task-base.h"
+
+namespace djetk {
+
+/**
+ * \brief CPU usage of the tasks created through \ref FreeRTOSTaskBase
+ *
+ * The FreeRTOS trace hooks accumulate the run time of each task as it is
+ * switched in and out, using the run time stats counter of the port
+ * (configGENERATE_RUN_TIME_STATS). Sampling only reads these counters, so it
+ * is cheap enough to do periodically (e.g. once a second) in production.
+ *
+ * - CPU percentages cover the window between the last two calls to \ref Sample
+ * - Time spent in ISRs is attributed to the interrupted task
+ * - Queue blocked time runs from blocking on a queue receive until the task
+ *   runs again, so it includes time spent ready but preempted
+ */
+class TaskStats {
+  public:
+    /**
+     * \brief Statistics of a single task
+     */
+    struct TaskInfo {
+        /**
+         * \brief Task name
+         */
+        const signed char *name;
+
+        /**
+         * \brief Accumulated run time
+         */
+        uint32_t run_time;
+
+        /**
+         * \brief Share of the CPU during the last window
+         */
+        uint32_t cpu_percent;
+
+        /**
+         * \brief Number of times the task was switched in
+         */
+        uint32_t switch_count;
+
+        /**
+         * \brief Accumulated time blocked on queue receives
+         */
+        uint32_t queue_blocked_time;
+    };
+
+    /**
+     * \brief Buffer pointer to a list (array) of task statistics
+     */
+    typedef buffptr<TaskInfo> TaskInfoList;
+
+    TaskStats();
+
+    /**
+     * \brief Close the current window and compute the CPU percentages
+     */
+    void Sample();
+
+    /**
+     * \brief Get the length of the last window in run time counter units
+     */
+    uint32_t GetWindow() const
+    {
+        return window_;
+    }
+
+    /**
+     * \brief Get the statistics of each task
+     * \param[out]  info    Buffer to write the statistics to
+     * \return Number of tasks written. Tasks that don't fit are left out.
+     */
+    size_t GetTaskInfo(TaskInfoList &info) const;
+
+  private:
+    uint32_t last_sample_time_;
+    uint32_t window_;
+};
+
+}   // namespace
+
+#endif
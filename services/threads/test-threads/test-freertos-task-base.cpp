@@ -0,0 +1,83 @@
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <array>
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-static-task.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Task on an embedded stack that does nothing
+ *
+ * The scheduler isn't started in this test app, so it never runs.
+ */
+class IdleStaticTask : public StaticTask<configMINIMAL_STACK_SIZE> {
+  public:
+    explicit IdleStaticTask(ICriticalErrorHandler &error_handler)
+    : StaticTask(error_handler, reinterpret_cast<const signed char *>("IDLE_STATIC"),
+            tskIDLE_PRIORITY)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        for (;;) {
+            vTaskSuspend(NULL);
+        }
+    }
+};
+
+/**
+ * \test Test that a task that can't get a stack slot is neither created nor registered
+ *
+ * Deleted tasks hold on to their slots until the idle task cleans them up,
+ * so this runs in an app of its own without starting the scheduler.
+ */
+void test_StaticTask_NoFreeStackSlot_NotCreatedNorRegistered()
+{
+    CriticalErrorHandlerStub error_handler;
+    std::array<IdleStaticTask *, FreeRTOSTaskBase::kMaxStaticStacks + 1> tasks;
+    size_t count = 0;
+    while (!error_handler.is_critical_error && (count < tasks.size())) {
+        tasks[count++] = new IdleStaticTask(error_handler);
+    }
+
+    TEST_ASSERT_TRUE(error_handler.is_critical_error);
+    TEST_ASSERT_EQUAL(FreeRTOSTaskBase::kMaxStaticStacks + 1, count);
+
+    auto failed = tasks[count - 1];
+    TEST_ASSERT_FALSE(failed->IsCreated());
+    TEST_ASSERT_TRUE(tasks[0]->IsCreated());
+
+    size_t registered = 0;
+    for (auto task = FreeRTOSTaskBase::GetFirstTask(); task != nullptr;
+            task = task->GetNextTask()) {
+        TEST_ASSERT_TRUE(task != failed);
+        registered++;
+    }
+    TEST_ASSERT_EQUAL(FreeRTOSTaskBase::kMaxStaticStacks, registered);
+
+    // Destroying the task that wasn't created leaves the others alone
+    delete failed;
+    TEST_ASSERT_EQUAL(tasks[count - 2], FreeRTOSTaskBase::GetFirstTask());
+
+    for (size_t i = 0; i < (count - 1); i++) {
+        delete tasks[i];
+    }
+    TEST_ASSERT_NULL(FreeRTOSTaskBase::GetFirstTask());
+}
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_StaticTask_NoFreeStackSlot_NotCreatedNorRegistered);
+    return UnityEnd();
+}
@@ -0,0 +1,358 @@
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <atomic>
+#include <limits>
+#include <array>
+#include <sched.h>
+#include <threads/native-task-base.h>
+#include <threads/native-queue-task.h>
+#include <threads/native-scheduler.h>
+#include <messaging/native-queue.h>
+#include <messaging/queue-dispatcher.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Task that records the CPU it ran on
+ *
+ * The last of a group of tasks to run stops the scheduler.
+ */
+class CpuRecorderTask : public NativeTaskBase {
+  public:
+    CpuRecorderTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            int cpu, std::atomic<size_t> &remaining)
+    : NativeTaskBase(scheduler, error_handler, "CPU_RECORDER", 1, cpu),
+    ran_on_cpu(-1),
+    scheduler_(scheduler),
+    remaining_(remaining)
+    {
+    }
+
+    /**
+     * \brief CPU the task ran on
+     */
+    int ran_on_cpu;
+
+  private:
+    virtual void TaskMain() override
+    {
+        ran_on_cpu = sched_getcpu();
+        if (--remaining_ == 0) {
+            scheduler_.Stop();
+        }
+    }
+
+    NativeScheduler &scheduler_;
+    std::atomic<size_t> &remaining_;
+};
+
+/**
+ * \brief Task that suspends itself and stops the scheduler once resumed
+ */
+class SuspendingTask : public NativeTaskBase {
+  public:
+    SuspendingTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler)
+    : NativeTaskBase(scheduler, error_handler, "SUSPENDING", 1),
+    resumed(false),
+    scheduler_(scheduler)
+    {
+    }
+
+    std::atomic<bool> resumed;
+
+  private:
+    virtual void TaskMain() override
+    {
+        Suspend();
+        resumed = true;
+        scheduler_.Stop();
+    }
+
+    NativeScheduler &scheduler_;
+};
+
+/**
+ * \brief Task that resumes another task
+ */
+class ResumingTask : public NativeTaskBase {
+  public:
+    ResumingTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            SuspendingTask &task)
+    : NativeTaskBase(scheduler, error_handler, "RESUMING", 0),
+    task_(task)
+    {
+    }
+
+  private:
+    virtual void TaskMain() override
+    {
+        // Keep resuming until the task has suspended itself
+        while (!task_.resumed) {
+            task_.Resume();
+            sched_yield();
+        }
+    }
+
+    SuspendingTask &task_;
+};
+
+/**
+ * \brief Test that tasks pinned to each CPU run there once the scheduler starts
+ */
+void test_Start_TasksPinnedToEachCpu_RunOnTheirCpu()
+{
+    static constexpr size_t kMaxTasks = 4;
+    auto task_count = std::min(kMaxTasks, NativeScheduler::GetCpuCount());
+    std::atomic<size_t> remaining(task_count);
+
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    std::array<CpuRecorderTask *, kMaxTasks> tasks;
+    for (size_t i = 0; i < task_count; i++) {
+        tasks[i] = new CpuRecorderTask(scheduler, error_handler, i, remaining);
+        tasks[i]->Start();
+    }
+
+    scheduler.Start();
+
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+    TEST_ASSERT_EQUAL(0, remaining);
+    for (size_t i = 0; i < task_count; i++) {
+        TEST_ASSERT_EQUAL(i, tasks[i]->ran_on_cpu);
+        tasks[i]->Stop();
+        delete tasks[i];
+    }
+}
+
+/**
+ * \brief Test that a scheduler can be started again after it was stopped
+ */
+void test_Start_AfterStop_RunsNewTasks()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+
+    for (int run = 0; run < 2; run++) {
+        std::atomic<size_t> remaining(1);
+        CpuRecorderTask task(scheduler, error_handler, NativeTaskBase::kAnyCpu, remaining);
+        task.Start();
+        scheduler.Start();
+        task.Stop();
+        TEST_ASSERT_EQUAL(0, remaining);
+    }
+
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that a suspended task runs again when resumed by another task
+ */
+void test_Resume_SuspendedTask_TaskContinues()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    SuspendingTask suspending(scheduler, error_handler);
+    ResumingTask resuming(scheduler, error_handler, suspending);
+    suspending.Start();
+    resuming.Start();
+
+    scheduler.Start();
+    suspending.Stop();
+    resuming.Stop();
+    TEST_ASSERT_TRUE(suspending.resumed);
+}
+
+/**
+ * \brief Test that a task stopped before the scheduler starts never runs
+ */
+void test_Stop_SchedulerNotStarted_TaskCancelled()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    std::atomic<size_t> remaining(1);
+
+    CpuRecorderTask task(scheduler, error_handler, NativeTaskBase::kAnyCpu, remaining);
+    TEST_ASSERT_FALSE(task.IsStarted());
+    task.Start();
+    TEST_ASSERT_TRUE(task.IsStarted());
+    task.Stop();
+    TEST_ASSERT_FALSE(task.IsStarted());
+
+    TEST_ASSERT_EQUAL(1, remaining);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that destroying a task that wasn't stopped is reported
+ */
+void test_Destroy_TaskNotStopped_ReportsError()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    std::atomic<size_t> remaining(1);
+
+    {
+        CpuRecorderTask task(scheduler, error_handler, NativeTaskBase::kAnyCpu, remaining);
+        task.Start();
+    }
+
+    TEST_ASSERT_TRUE(error_handler.is_critical_error);
+    TEST_ASSERT_EQUAL(ICriticalErrorHandler::os_error, error_handler.last_error_code);
+    TEST_ASSERT_EQUAL(1, remaining);
+}
+
+/**
+ * \brief Task that starts another task while the scheduler is running
+ */
+class SpawningTask : public NativeTaskBase {
+  public:
+    SpawningTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            CpuRecorderTask &task)
+    : NativeTaskBase(scheduler, error_handler, "SPAWNING", 1),
+    task_(task)
+    {
+    }
+
+  private:
+    virtual void TaskMain() override
+    {
+        task_.Start();
+    }
+
+    CpuRecorderTask &task_;
+};
+
+/**
+ * \brief Test that a task started while the scheduler is running runs straight away
+ */
+void test_Start_SchedulerRunning_TaskRuns()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    std::atomic<size_t> remaining(1);
+    CpuRecorderTask task(scheduler, error_handler, NativeTaskBase::kAnyCpu, remaining);
+    SpawningTask spawning(scheduler, error_handler, task);
+    spawning.Start();
+
+    scheduler.Start();
+    spawning.Stop();
+    task.Stop();
+
+    TEST_ASSERT_EQUAL(0, remaining);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Handler that counts messages and stops the scheduler after the last one
+ */
+class CountingHandler : public IMessageHandler {
+  public:
+    CountingHandler(NativeScheduler &scheduler, uint32_t expected)
+    : count(0),
+    sum(0),
+    scheduler_(scheduler),
+    expected_(expected)
+    {
+    }
+
+    virtual bool HandleMessage(const Message &msg) override
+    {
+        sum += msg.payload.data;
+        if (++count == expected_) {
+            scheduler_.Stop();
+        }
+
+        return true;
+    }
+
+    std::atomic<uint32_t> count;
+    std::atomic<size_t> sum;
+
+  private:
+    NativeScheduler &scheduler_;
+    uint32_t expected_;
+};
+
+/**
+ * \brief Task that posts a single message, waiting for room
+ */
+class PostingTask : public NativeTaskBase {
+  public:
+    PostingTask(NativeScheduler &scheduler, ICriticalErrorHandler &error_handler,
+            IMessageQueue &queue, const Message &message)
+    : NativeTaskBase(scheduler, error_handler, "POSTING", 1),
+    queue_(queue),
+    message_(message)
+    {
+    }
+
+  private:
+    virtual void TaskMain() override
+    {
+        queue_.PostMessage(message_, std::numeric_limits<uint32_t>::max());
+    }
+
+    IMessageQueue &queue_;
+    Message message_;
+};
+
+/**
+ * \brief Test that a queue task dispatches the posted messages and stops while blocked
+ */
+void test_NativeQueueTask_MessagesPosted_DispatchedAndStopsWhileBlocked()
+{
+    CriticalErrorHandlerStub error_handler;
+    NativeScheduler scheduler;
+    NativeQueue queue(2);
+    QueueDispatcher dispatcher(queue);
+    CountingHandler handler(scheduler, 3);
+    dispatcher.RegisterHandler(handler);
+    NativeQueueTask task(scheduler, error_handler, "QUEUE", 1, dispatcher);
+    PostingTask posting(scheduler, error_handler, queue, Message(1, static_cast<size_t>(4)));
+    task.Start();
+    posting.Start();
+
+    // The queue stays full until the scheduler releases the tasks
+    bool task_woken = false;
+    TEST_ASSERT_TRUE(queue.PostMessage(Message(1, static_cast<size_t>(1)), 0));
+    TEST_ASSERT_TRUE(queue.PostMessageFromIsr(Message(1, static_cast<size_t>(2)), task_woken));
+    TEST_ASSERT_FALSE(task_woken);
+    TEST_ASSERT_FALSE(queue.PostMessage(Message(1, static_cast<size_t>(8)), 10));
+
+    scheduler.Start();
+
+    // The queue task is blocked waiting for the next message
+    task.Stop();
+    posting.Stop();
+
+    TEST_ASSERT_EQUAL(3, handler.count);
+    TEST_ASSERT_EQUAL(7, handler.sum);
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that task priorities saturate at the highest real time priority
+ */
+void test_MapPriority_AboveRange_Saturates()
+{
+    TEST_ASSERT_EQUAL(sched_get_priority_min(SCHED_FIFO), NativeTaskBase::MapPriority(0));
+    TEST_ASSERT_EQUAL(sched_get_priority_max(SCHED_FIFO), NativeTaskBase::MapPriority(1000));
+}
+
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_Start_TasksPinnedToEachCpu_RunOnTheirCpu);
+    RUN_TEST(test_Start_AfterStop_RunsNewTasks);
+    RUN_TEST(test_Resume_SuspendedTask_TaskContinues);
+    RUN_TEST(test_Stop_SchedulerNotStarted_TaskCancelled);
+    RUN_TEST(test_Destroy_TaskNotStopped_ReportsError);
+    RUN_TEST(test_Start_SchedulerRunning_TaskRuns);
+    RUN_TEST(test_NativeQueueTask_MessagesPosted_DispatchedAndStopsWhileBlocked);
+    RUN_TEST(test_MapPriority_AboveRange_Saturates);
+    return UnityEnd();
+}
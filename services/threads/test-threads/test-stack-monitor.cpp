@@ -0,0 +1,123 @@
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <array>
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-scheduler.h>
+#include <threads/stack-monitor.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Stack depth of the test task in words
+ */
+static constexpr unsigned short kStackDepth = 4096;
+
+/**
+ * \brief Number of stack words the test task uses on top of its own frames.
+ *        Over half the depth, so doubling it doesn't fit.
+ */
+static constexpr size_t kUsedWords = 2200;
+
+/**
+ * \brief Fill a local buffer so that its words are taken off the paint
+ *
+ * Kept out of line so that the buffer is on the stack below the caller.
+ */
+static __attribute__((noinline)) void UseStack()
+{
+    volatile portSTACK_TYPE buffer[kUsedWords];
+    for (size_t i = 0; i < kUsedWords; i++) {
+        buffer[i] = 0;
+    }
+    (void)buffer;
+}
+
+/**
+ * \brief Task that uses a known amount of stack and stops the scheduler
+ */
+class StackUserTask : public FreeRTOSTaskBase {
+  public:
+    StackUserTask(ICriticalErrorHandler &error_handler, FreeRTOSScheduler &scheduler)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("STACK_USER"),
+            kStackDepth, tskIDLE_PRIORITY + 1),
+    scheduler_(scheduler)
+    {
+    }
+
+ private:
+    virtual void TaskMain()
+    {
+        UseStack();
+        scheduler_.Stop();
+    }
+
+    FreeRTOSScheduler &scheduler_;
+};
+
+/**
+ * \test Test that the stack monitor reports the stack used by a task
+ *
+ * The scheduler can only be started once, so this runs in an app of its own.
+ * On the POSIX port the port's signal handlers also run on the painted
+ * stack and can only add to the peak, so the peak is checked to cover the
+ * known usage rather than to match it.
+ */
+void test_GetStackInfo_TaskUsedKnownStack_ReportsPeakAndMargin()
+{
+    auto &scheduler = FreeRTOSScheduler::GetScheduler();
+    CriticalErrorHandlerStub error_handler;
+    StackUserTask task(error_handler, scheduler);
+
+    // Nothing is measured before the task runs
+    TEST_ASSERT_FALSE(task.IsStackPainted());
+    TEST_ASSERT_EQUAL(0, task.GetStackUnusedWords());
+
+    scheduler.Start();
+
+    TEST_ASSERT_TRUE(task.IsStackPainted());
+    auto unused = task.GetStackUnusedWords();
+
+    std::array<StackMonitor::StackInfo, 2> info_buffer;
+    StackMonitor::StackInfoList info(info_buffer.data(), info_buffer.size());
+
+    StackMonitor monitor(25);
+    TEST_ASSERT_EQUAL(1, monitor.GetStackInfo(info));
+    auto &entry = info_buffer[0];
+    TEST_ASSERT_EQUAL_STRING("STACK_USER", reinterpret_cast<const char *>(entry.name));
+    TEST_ASSERT_EQUAL(kStackDepth, entry.depth);
+    TEST_ASSERT_EQUAL(kStackDepth - unused, entry.peak_used);
+
+    // Usage is measured from the frame that painted, which may sit a few
+    // words below the caller of the frame that used the stack
+    TEST_ASSERT_TRUE((entry.peak_used + FreeRTOSTaskBase::kPaintMarginWords) >= kUsedWords);
+    TEST_ASSERT_EQUAL((unused * 100) / kStackDepth, entry.margin_percent);
+    TEST_ASSERT_EQUAL(entry.peak_used + ((entry.peak_used * 25) + 99) / 100,
+            entry.recommended_depth);
+    TEST_ASSERT_EQUAL(kStackDepth < entry.recommended_depth, entry.below_margin);
+
+    // No margin is met by any depth that fits the peak, while a 100% margin
+    // doesn't fit as the task uses over half its depth
+    StackMonitor no_margin(0);
+    TEST_ASSERT_EQUAL(1, no_margin.GetStackInfo(info));
+    TEST_ASSERT_EQUAL(entry.peak_used, entry.recommended_depth);
+    TEST_ASSERT_FALSE(entry.below_margin);
+
+    StackMonitor double_margin(100);
+    TEST_ASSERT_EQUAL(1, double_margin.GetStackInfo(info));
+    TEST_ASSERT_EQUAL(2 * entry.peak_used, entry.recommended_depth);
+    TEST_ASSERT_TRUE(entry.below_margin);
+}
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_GetStackInfo_TaskUsedKnownStack_ReportsPeakAndMargin);
+    return UnityEnd();
+}
@@ -5,11 +5,16 @@ extern "C"
 
 #include <array>
 #include <threads/freertos-task-base.h>
+#include <threads/freertos-static-task.h>
+#include <threads/active-object.h>
+#include <threads/task-stats.h>
+#include <threads/stack-paint.h>
 #include <threads/freertos-queue-task.h>
 #include <threads/freertos-scheduler.h>
 #include <messaging/freertos-queue.h>
 #include <messaging/queue-dispatcher.h>
 #include <testing/critical-error-handler-stub.h>
+#include <testing/cycle-counter-stub.h>
 
 using namespace djetk;
 
@@ -82,9 +87,9 @@ typedef std::array<int,kDataSetSize> TestDataSet;
  * \brief Data producer task
  *
  * This task generates an injected dataset to an injected message queue interface
- * afterwards it suspends itself
+ * afterwards it suspends itself. It runs on a statically allocated stack.
  */
-class TestProducerTask : public FreeRTOSTaskBase {
+class TestProducerTask : public StaticTask<100> {
   public:
     /**
      * \brief Class constructor
@@ -94,8 +99,8 @@ class TestProducerTask : public FreeRTOSTaskBase {
      */
     TestProducerTask(ICriticalErrorHandler &error_handler, const TestDataSet& data_set,
             IMessageQueue &message_queue)
-    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("PRODUCER"),
-            100, kProducerPriority),
+    : StaticTask(error_handler, reinterpret_cast<const signed char *>("PRODUCER"),
+            kProducerPriority),
     data_set_(data_set),
     message_queue_(message_queue)
     {
@@ -213,6 +218,173 @@ void test_ThreadSpaceQueueSendAndReceive()
     TEST_ASSERT(kProducerData == consumer_data);
 }
 
+/**
+ * \brief Active object that records the last message it handled
+ */
+class TestActiveObject : public ActiveObject<TestActiveObject, 4, 100> {
+  public:
+    /**
+     * \brief Construct the active object
+     * \param[in]   error_handler   Reference to critical error handler
+     * \param[in]   cycle_counter   Clock used to measure the metrics
+     */
+    TestActiveObject(ICriticalErrorHandler &error_handler, ICycleCounter &cycle_counter)
+        : ActiveObject(error_handler, cycle_counter,
+                reinterpret_cast<const signed char *>("ACTIVE"), tskIDLE_PRIORITY + 1),
+        handled_count(0)
+    {
+    }
+
+    /**
+     * \brief Dispatched (non-virtually) by \ref ActiveObject
+     */
+    bool HandleMessage(const Message &msg)
+    {
+        msg_in = msg;
+        handled_count++;
+        return true;
+    }
+
+    /**
+     * \brief Account for handled messages at a given tick count
+     * \return The message rate
+     */
+    uint32_t UpdateMessageRateAt(portTickType now, uint32_t messages)
+    {
+        return UpdateMessageRate(now, messages);
+    }
+
+    /**
+     * \brief Copy of the last handled message
+     */
+    Message msg_in;
+
+    /**
+     * \brief Number of handled messages
+     */
+    int handled_count;
+};
+
+/**
+ * \brief Test that an active object handles its posted messages and measures
+ *        the queue residency and the run to completion time
+ *
+ * The object is dispatched manually. Its task never runs as the scheduler
+ * isn't started.
+ */
+void test_ActiveObject_MessagePosted_HandledAndMeasured()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    cycle_counter.step = 100;
+    TestActiveObject active_object(error_handler, cycle_counter);
+
+    // Posting stamps the message at cycle 0
+    TEST_ASSERT_TRUE(active_object.PostMessage(Message(7, static_cast<size_t>(42)), 0));
+
+    // Received at cycle 100, handler starts at 200 and completes at 300
+    TEST_ASSERT_TRUE(active_object.Dispatch(Ticks(0)));
+    TEST_ASSERT_EQUAL(1, active_object.handled_count);
+    TEST_ASSERT_EQUAL(7, active_object.msg_in.id);
+    TEST_ASSERT_EQUAL(42, active_object.msg_in.payload.data);
+    TEST_ASSERT_EQUAL(100, active_object.GetResidencyStats().GetMax());
+    TEST_ASSERT_EQUAL(100, active_object.GetRunToCompletionStats().GetMax());
+
+    TEST_ASSERT_FALSE(active_object.Dispatch(Ticks(0)));
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+}
+
+/**
+ * \brief Test that the message rate is scaled to the window length and decays
+ *        when messages stop
+ */
+void test_ActiveObject_MessageRate_ScaledToWindowAndDecays()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    TestActiveObject active_object(error_handler, cycle_counter);
+    static constexpr portTickType kSecond = configTICK_RATE_HZ;
+
+    // The window stays open for a second
+    TEST_ASSERT_EQUAL(0, active_object.UpdateMessageRateAt(kSecond / 2, 50));
+
+    // 100 messages over a window stretched to 4 seconds by an idle gap
+    TEST_ASSERT_EQUAL(25, active_object.UpdateMessageRateAt(4 * kSecond, 50));
+
+    // A read a second later without messages
+    TEST_ASSERT_EQUAL(25, active_object.UpdateMessageRateAt(4 * kSecond + 10, 0));
+    TEST_ASSERT_EQUAL(0, active_object.UpdateMessageRateAt(5 * kSecond, 0));
+}
+
+/**
+ * \brief Test that posting from an ISR keeps a task_woken set by an earlier call
+ *
+ * The object's task isn't waiting on the queue, so the post wakes nothing.
+ */
+void test_ActiveObject_PostMessageFromIsr_KeepsEarlierTaskWoken()
+{
+    CriticalErrorHandlerStub error_handler;
+    CycleCounterStub cycle_counter;
+    TestActiveObject active_object(error_handler, cycle_counter);
+
+    bool task_woken = true;
+    TEST_ASSERT_TRUE(active_object.PostMessageFromIsr(Message(7, nullptr), task_woken));
+    TEST_ASSERT_TRUE(task_woken);
+
+    task_woken = false;
+    TEST_ASSERT_TRUE(active_object.PostMessageFromIsr(Message(8, nullptr), task_woken));
+    TEST_ASSERT_FALSE(task_woken);
+}
+
+/**
+ * \brief Test that the trace hooks account for run time, switches and queue
+ *        blocking of tagged tasks
+ *
+ * The hooks are invoked directly with the counters as the task tags.
+ */
+void test_TraceHooks_TasksSwitched_CountersUpdated()
+{
+    TaskRunTimeCounters task_a;
+    TaskRunTimeCounters task_b;
+
+    // A runs from 100 to 150 and blocks on a queue
+    vApplicationTaskSwitchedIn(&task_a, 100);
+    vApplicationTaskBlockingOnQueue(&task_a, 150);
+    vApplicationTaskSwitchedOut(&task_a, 150);
+
+    // B runs from 150 to 200, then the tick reselects B until 230
+    vApplicationTaskSwitchedIn(&task_b, 150);
+    vApplicationTaskSwitchedOut(&task_b, 200);
+    vApplicationTaskSwitchedIn(&task_b, 200);
+    vApplicationTaskSwitchedOut(&task_b, 230);
+
+    // A receives its message
+    vApplicationTaskSwitchedIn(&task_a, 230);
+
+    TEST_ASSERT_EQUAL(50, task_a.run_time);
+    TEST_ASSERT_EQUAL(2, task_a.switch_count);
+    TEST_ASSERT_EQUAL(80, task_a.queue_blocked_time);
+    TEST_ASSERT_EQUAL(80, task_b.run_time);
+    TEST_ASSERT_EQUAL(1, task_b.switch_count);
+    TEST_ASSERT_EQUAL(0, task_b.queue_blocked_time);
+}
+
+/**
+ * \brief Test that the unused part of a painted stack is measured from the bottom
+ */
+void test_StackPaint_TopOfStackUsed_CountsUntouchedWordsFromBottom()
+{
+    std::array<portSTACK_TYPE, 16> stack;
+    StackPaint::Paint(stack.data(), stack.size());
+    TEST_ASSERT_EQUAL(16, StackPaint::CountUnused(stack.data(), stack.size()));
+
+    // The stack grows down from the top, so using it overwrites the top words
+    stack[12] = 0;
+    TEST_ASSERT_EQUAL(12, StackPaint::CountUnused(stack.data(), stack.size()));
+    stack[15] = 0;
+    TEST_ASSERT_EQUAL(12, StackPaint::CountUnused(stack.data(), stack.size()));
+}
+
 extern "C" void vApplicationTickHook()
 {
 }
@@ -223,6 +395,11 @@ int main()
     // FreeRTOS posix appears to have a problem with stopping and starting the
     // scheduler so there's only one test enabled at the moment
 //    RUN_TEST(test_ThreadEntryInvocation);
+    RUN_TEST(test_ActiveObject_MessagePosted_HandledAndMeasured);
+    RUN_TEST(test_ActiveObject_PostMessageFromIsr_KeepsEarlierTaskWoken);
+    RUN_TEST(test_ActiveObject_MessageRate_ScaledToWindowAndDecays);
+    RUN_TEST(test_TraceHooks_TasksSwitched_CountersUpdated);
+    RUN_TEST(test_StackPaint_TopOfStackUsed_CountsUntouchedWordsFromBottom);
     RUN_TEST(test_ThreadSpaceQueueSendAndReceive);
     return UnityEnd();
 }
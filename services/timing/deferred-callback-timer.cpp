@@ -0,0 +1,103 @@
+/**
+    \file
+    \brief Deferred callback timer implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <timing/deferred-callback-timer.h>
+
+namespace djetk {
+
+TimerDaemon::TimerDaemon(IMessageQueue &message_queue)
+    : message_queue_(message_queue)
+{
+}
+
+bool TimerDaemon::HandleMessage(const Message &msg)
+{
+    // The payload identifies the timer and the id carries the reference
+    // the timer was started with.
+    auto timer = static_cast<DeferredCallbackTimer *>(const_cast<void *>(msg.payload.pdata));
+    if (timer == nullptr) {
+        return false;
+    }
+
+    {
+        AutoInterruptDisabler disabler(timer->os_services_);
+        timer->pending_expiries_--;
+    }
+
+    // The timer mustn't be touched after this as the callback may destroy it
+    timer->callback_.OnTimeout(static_cast<int>(msg.id));
+    return true;
+}
+
+DeferredCallbackTimer::DeferredCallbackTimer(ITickSource &tick_source, TimerDaemon &daemon,
+            ITimerCallback &callback, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services)
+    : TimerBase(tick_source, error_handler, os_services),
+    daemon_(daemon),
+    callback_(callback),
+    error_handler_(error_handler),
+    os_services_(os_services),
+    pending_expiries_(0)
+{
+}
+
+DeferredCallbackTimer::DeferredCallbackTimer(ITickSource &tick_source, TimerDaemon &daemon,
+            ITimerCallback &callback, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group)
+    : TimerBase(tick_source, error_handler, os_services, group),
+    daemon_(daemon),
+    callback_(callback),
+    error_handler_(error_handler),
+    os_services_(os_services),
+    pending_expiries_(0)
+{
+}
+
+DeferredCallbackTimer::~DeferredCallbackTimer()
+{
+    Stop();
+
+    bool pending;
+    {
+        AutoInterruptDisabler disabler(os_services_);
+        pending = (pending_expiries_ != 0);
+    }
+
+    if (pending) {
+        error_handler_.NotifyCriticalError(ICriticalErrorHandler::lifetime_error,
+                __FILE__, __LINE__);
+    }
+}
+
+bool DeferredCallbackTimer::OnExpiryFromIsr(int reference, bool &task_woken)
+{
+    Message message(static_cast<uint32_t>(reference), this);
+    if (!daemon_.message_queue_.PostMessageFromIsr(message, task_woken)) {
+        return false;
+    }
+
+    pending_expiries_++;
+    return true;
+}
+
+}    // namespace djetk
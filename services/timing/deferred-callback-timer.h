@@ -0,0 +1,144 @@
+/**
+    \file
+    \brief Timer that invokes a callback from a timer daemon task
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DEFERRED_CALLBACK_TIMER_H
+#define DEFERRED_CALLBACK_TIMER_H
+
+#include <timing/timer-base.h>
+#include <timing/itimer-callback.h>
+#include <messaging/imessage-queue.h>
+#include <messaging/imessage-dispatcher.h>
+
+namespace djetk {
+
+/**
+ * \brief Message handler that invokes the callbacks of expired
+ *        \ref DeferredCallbackTimer objects
+ *
+ * A single daemon services all deferred callback timers. It's wired up like
+ * any other message handler: the daemon queue is polled by a
+ * \ref QueueDispatcher running in a FreeRTOSQueueTask, with the daemon
+ * registered as the dispatcher's handler. The queue must be dedicated to
+ * the daemon.
+ *
+ * Callbacks run in the context of that task, one after the other, so a slow
+ * callback delays the others.
+ */
+class TimerDaemon : public IMessageHandler {
+  public:
+    /**
+     * \brief Construct the daemon
+     * \param[in]   message_queue   Queue the expired timers are posted to
+     */
+    explicit TimerDaemon(IMessageQueue &message_queue);
+
+    /**
+     * \brief See \ref IMessageHandler::HandleMessage
+     *
+     * The expiry is no longer pending once the callback is invoked.
+     */
+    virtual bool HandleMessage(const Message &msg) override;
+
+  private:
+    friend class DeferredCallbackTimer;
+
+    IMessageQueue &message_queue_;
+};
+
+/**
+ * \brief Timer that invokes a callback from the timer daemon task
+ *
+ * On expiry the timer posts itself to the \ref TimerDaemon queue. The daemon
+ * invokes the callback in task context, so unlike a \ref TimerObject no
+ * message ID has to be allocated and handled by the application.
+ *
+ * The queued message points at the timer, so the timer must outlive its
+ * queued expiries. Stopping the timer doesn't remove an expiry that's
+ * already queued; check \ref IsExpiryPending before destroying it. A timer
+ * may be destroyed from its own callback. Destroying a timer with an expiry
+ * pending is reported as \ref ICriticalErrorHandler::lifetime_error.
+ */
+class DeferredCallbackTimer : public TimerBase {
+  public:
+    /**
+     * \brief Construct a deferred callback timer
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   daemon          Daemon to invoke the callback from
+     * \param[in]   callback        Callback invoked on expiry
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     */
+    DeferredCallbackTimer(ITickSource &tick_source, TimerDaemon &daemon,
+            ITimerCallback &callback, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services);
+
+    /**
+     * \brief Construct a deferred callback timer that belongs to a coalescing group
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   daemon          Daemon to invoke the callback from
+     * \param[in]   callback        Callback invoked on expiry
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     * \param[in]   group           Group to coalesce expiries with
+     */
+    DeferredCallbackTimer(ITickSource &tick_source, TimerDaemon &daemon,
+            ITimerCallback &callback, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group);
+
+    /**
+     * \brief Stop the timer and check that no expiry is left queued
+     */
+    virtual ~DeferredCallbackTimer();
+
+    /**
+     * \brief Check whether an expiry is queued up for the daemon
+     */
+    bool IsExpiryPending() const
+    {
+        return pending_expiries_ != 0;
+    }
+
+  private:
+    friend class TimerDaemon;
+
+    TimerDaemon &daemon_;
+    ITimerCallback &callback_;
+    ICriticalErrorHandler &error_handler_;
+    IOsServices &os_services_;
+
+    /**
+     * \brief Number of expiries posted to the daemon that it hasn't handled.
+     *        Incremented from the tick ISR, decremented with interrupts
+     *        disabled.
+     */
+    volatile uint32_t pending_expiries_;
+
+    /**
+     * \brief See \ref TimerBase::OnExpiryFromIsr
+     */
+    virtual bool OnExpiryFromIsr(int reference, bool &task_woken) override;
+};
+
+}    // namespace djetk
+
+#endif    // DEFERRED_CALLBACK_TIMER_H
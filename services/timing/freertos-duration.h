@@ -0,0 +1,196 @@
+/**
+    \file
+    \brief Compile time durations and conversion to FreeRTOS ticks
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_DURATION_H
+#define FREERTOS_DURATION_H
+
+#include <cstdint>
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+
+namespace djetk {
+
+/**
+ * \brief Duration in milliseconds
+ *
+ * Create these with the literals in \ref djetk::literals (e.g. 250_ms).
+ */
+class Milliseconds {
+  public:
+    /**
+     * \brief Construct a duration
+     * \param[in]   count   Number of milliseconds
+     */
+    constexpr explicit Milliseconds(uint64_t count)
+        : count_(count) {}
+
+    /**
+     * \brief Get the number of milliseconds
+     */
+    constexpr uint64_t Count() const
+    {
+        return count_;
+    }
+
+  private:
+    uint64_t count_;
+};
+
+/**
+ * \brief Rounding policy that truncates partial ticks
+ */
+struct RoundDown {
+    static constexpr uint64_t Divide(uint64_t numerator, uint64_t denominator)
+    {
+        return numerator / denominator;
+    }
+};
+
+/**
+ * \brief Rounding policy that rounds partial ticks up. A timeout never
+ *        elapses early with this policy.
+ */
+struct RoundUp {
+    static constexpr uint64_t Divide(uint64_t numerator, uint64_t denominator)
+    {
+        return (numerator + denominator - 1) / denominator;
+    }
+};
+
+/**
+ * \brief Rounding policy that rounds to the nearest tick
+ */
+struct RoundNearest {
+    static constexpr uint64_t Divide(uint64_t numerator, uint64_t denominator)
+    {
+        return (numerator + (denominator / 2)) / denominator;
+    }
+};
+
+/**
+ * \cond IGNORE_DOCS
+ */
+namespace detail {
+
+// Deliberately not constexpr: reaching it during constant evaluation fails
+// the compilation. At run time the tick count saturates.
+inline portTickType TickCountOverflow()
+{
+    return portMAX_DELAY - 1;
+}
+
+constexpr portTickType CheckedTickCount(uint64_t ticks)
+{
+    return (ticks < portMAX_DELAY) ? static_cast<portTickType>(ticks) : TickCountOverflow();
+}
+
+}   // namespace detail
+/**
+ * \endcond
+ */
+
+/**
+ * \brief Duration in FreeRTOS kernel ticks
+ *
+ * Implicitly converts from \ref Milliseconds, rounding up. Declaring the
+ * value constexpr guarantees the conversion happens at compile time, and
+ * durations that don't fit portTickType fail to compile:
+ * \code
+ * static constexpr Ticks kTimeout = 250_ms;
+ * static constexpr Ticks kBad = 5000000000_ms;    // error
+ * \endcode
+ *
+ * \note portMAX_DELAY is reserved to mean wait forever (see \ref Infinite).
+ */
+class Ticks {
+  public:
+    /**
+     * \brief Construct from a raw tick count
+     * \param[in]   count   Number of ticks
+     */
+    constexpr explicit Ticks(portTickType count)
+        : count_(count) {}
+
+    /**
+     * \brief Construct from milliseconds, rounding up to the next tick
+     * \param[in]   duration    Duration to convert
+     */
+    constexpr Ticks(Milliseconds duration)
+        : count_(detail::CheckedTickCount(RoundUp::Divide(duration.Count(), portTICK_RATE_MS))) {}
+
+    /**
+     * \brief Get the number of ticks
+     */
+    constexpr portTickType Count() const
+    {
+        return count_;
+    }
+
+    /**
+     * \brief Duration that never elapses
+     */
+    static constexpr Ticks Infinite()
+    {
+        return Ticks(portMAX_DELAY);
+    }
+
+  private:
+    portTickType count_;
+};
+
+/**
+ * \brief Convert milliseconds to ticks with an explicit rounding policy
+ * \param Rounding  One of \ref RoundDown, \ref RoundUp or \ref RoundNearest
+ * \param[in]   duration    Duration to convert
+ */
+template <class Rounding>
+constexpr Ticks ToTicks(Milliseconds duration)
+{
+    return Ticks(detail::CheckedTickCount(Rounding::Divide(duration.Count(), portTICK_RATE_MS)));
+}
+
+/**
+ * \brief User defined literals for durations
+ */
+namespace literals {
+
+/**
+ * \brief Milliseconds literal (e.g. 250_ms)
+ */
+constexpr Milliseconds operator"" _ms(unsigned long long count)
+{
+    return Milliseconds(count);
+}
+
+/**
+ * \brief Seconds literal (e.g. 2_s)
+ */
+constexpr Milliseconds operator"" _s(unsigned long long count)
+{
+    return Milliseconds(count * 1000);
+}
+
+}   // namespace literals
+
+}   // namespace djetk
+
+#endif  // FREERTOS_DURATION_H
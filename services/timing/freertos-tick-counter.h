@@ -0,0 +1,51 @@
+/**
+    \file
+    \brief FreeRTOS kernel tick counter
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FREERTOS_TICK_COUNTER_H
+#define FREERTOS_TICK_COUNTER_H
+
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include <timing/itick-counter.h>
+
+namespace djetk {
+
+/**
+ * \brief Reads the FreeRTOS kernel tick count
+ *
+ * For use in task context only.
+ */
+class FreeRTOSTickCounter : public ITickCounter {
+  public:
+    /**
+     * \brief See \ref ITickCounter::GetTickCount
+     */
+    virtual uint32_t GetTickCount() const override
+    {
+        return xTaskGetTickCount();
+    }
+};
+
+}    // namespace djetk
+
+#endif    // FREERTOS_TICK_COUNTER_H
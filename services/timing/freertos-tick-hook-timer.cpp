@@ -24,18 +24,17 @@
 #include <FreeRTOS/Source/include/FreeRTOS.h>
 #include <timing/freertos-tick-hook-timer.h>
 #include <timing/freertos-ticks.h>
+#include <isr/freertos-isr-vector.h>
 
 namespace djetk {
 
 FreeRTOSTickHookTimer::FreeRTOSTickHookTimer(TickClientsList &clients_buffer,
         ICriticalErrorHandler &error_handler)
-    : clients_buffer_(clients_buffer),
-    last_registered_client_(clients_buffer.begin()),
-    error_handler_(error_handler)
+    : clients_(clients_buffer, error_handler)
 {
     // We're running off the tick hook isr. So register ourselves for that service
     if (!tick_hook_isr_.RegisterHandler(*this)) {
-        error_handler_.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
             __FILE__, __LINE__);
     }
 }
@@ -47,14 +46,13 @@ FreeRTOSTickHookTimer::~FreeRTOSTickHookTimer()
 
 bool FreeRTOSTickHookTimer::RegisterTickClient(ITickClient &client)
 {
-    // Register the client if the buffer is not full
-    if (last_registered_client_ == clients_buffer_.end()) {
-        return false;
-    }
+    return clients_.Register(client);
+}
 
-    *last_registered_client_= &client;
-    last_registered_client_++;
-    return true;
+bool FreeRTOSTickHookTimer::EnableAccounting(ICycleCounter &cycle_counter,
+        ExecutionStatsList &stats)
+{
+    return clients_.EnableAccounting(cycle_counter, stats);
 }
 
 uint32_t FreeRTOSTickHookTimer::MsToTicks(uint32_t milliseconds)
@@ -63,17 +61,14 @@ uint32_t FreeRTOSTickHookTimer::MsToTicks(uint32_t milliseconds)
     return ticks;
 }
 
+uint32_t FreeRTOSTickHookTimer::KernelTicksToTicks(uint32_t kernel_ticks)
+{
+    return kernel_ticks;
+}
+
 void FreeRTOSTickHookTimer::HandleIsr(bool &task_woken)
 {
-    // Notify all the registered tick clients that a tick event has occurred
-    for (auto it = clients_buffer_.begin(); it != last_registered_client_; it++) {
-        auto result = (*it)->OnTickFromIsr(task_woken);
-        // Notify error handler if failed to write to queue
-        if (!result) {
-            error_handler_.NotifyCriticalError(ICriticalErrorHandler::isr_handler_error,
-                __FILE__, __LINE__);
-        }
-    }
+    clients_.NotifyTickFromIsr(task_woken);
 }
 
 /**
@@ -83,10 +78,7 @@ void FreeRTOSTickHookTimer::HandleIsr(bool &task_woken)
  */
 extern "C" void vApplicationTickHook()
 {
-    bool task_woken = false;
-    IsrService<FreeRTOSTickHookTimer>::ISR(task_woken);
-    // TODO Enable following line.
-    //portEND_SWITCHING_ISR(task_woken ? pdTRUE : pdFALSE);
+    FreeRTOSIsrVector<IsrService<FreeRTOSTickHookTimer>>();
 }
 
 }    // namespace djetk
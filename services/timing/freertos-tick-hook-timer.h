@@ -24,20 +24,13 @@
 #ifndef FREERTOS_TICK_HOOK_TIMER_H
 #define FREERTOS_TICK_HOOK_TIMER_H
 
-#include <iterator>
 #include <timing/itick-source.h>
+#include <timing/tick-client-registry.h>
 #include <isr/isr-service.h>
-#include <utilities/buffptr.h>
 #include <errors/icritical-error-handler.h>
 
 namespace djetk {
 
-// typedef of tick client pointer list to make it easier to use later on
-/**
- * \brief Buffer pointer to a list (array) of tick clients
- */
-typedef buffptr<ITickClient*> TickClientsList;
-
 /**
  * \brief FreeRTOS Tick Hook Timer definition
  *
@@ -75,6 +68,18 @@ class FreeRTOSTickHookTimer : public ITickSource,
      */
     virtual uint32_t MsToTicks(uint32_t milliseconds) override;
 
+    /**
+     * \brief See \ref ITickSource::KernelTicksToTicks
+     */
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) override;
+
+    /**
+     * \brief Measure the execution time of each registered client
+     *
+     * See \ref TickClientRegistry::EnableAccounting
+     */
+    bool EnableAccounting(ICycleCounter &cycle_counter, ExecutionStatsList &stats);
+
   private:
     // Methods from IIsrHandler
     /**
@@ -82,10 +87,7 @@ class FreeRTOSTickHookTimer : public ITickSource,
      */
     virtual void HandleIsr(bool &task_woken) override;
     IsrService<FreeRTOSTickHookTimer> tick_hook_isr_;
-    TickClientsList &clients_buffer_;
-
-    TickClientsList::iterator last_registered_client_;
-    ICriticalErrorHandler &error_handler_;
+    TickClientRegistry clients_;
 };
 
 }    // namespace djetk
@@ -0,0 +1,48 @@
+/**
+    \file
+    \brief ISR callback timer implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <timing/isr-callback-timer.h>
+
+namespace djetk {
+
+IsrCallbackTimer::IsrCallbackTimer(ITickSource &tick_source, IIsrTimerCallback &callback,
+            ICriticalErrorHandler &error_handler, IOsServices &os_services)
+    : TimerBase(tick_source, error_handler, os_services),
+    callback_(callback)
+{
+}
+
+IsrCallbackTimer::IsrCallbackTimer(ITickSource &tick_source, IIsrTimerCallback &callback,
+            ICriticalErrorHandler &error_handler, IOsServices &os_services,
+            TimerCoalescingGroup &group)
+    : TimerBase(tick_source, error_handler, os_services, group),
+    callback_(callback)
+{
+}
+
+bool IsrCallbackTimer::OnExpiryFromIsr(int reference, bool &task_woken)
+{
+    return callback_.OnTimeoutFromIsr(reference, task_woken);
+}
+
+}    // namespace djetk
@@ -0,0 +1,80 @@
+/**
+    \file
+    \brief Timer that invokes a callback from the tick ISR
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ISR_CALLBACK_TIMER_H
+#define ISR_CALLBACK_TIMER_H
+
+#include <timing/timer-base.h>
+#include <timing/itimer-callback.h>
+
+namespace djetk {
+
+/**
+ * \brief Timer that invokes a callback directly from the tick ISR
+ *
+ * This skips the message queue round trip entirely and is meant for trivial
+ * actions such as toggling a pin or kicking a peripheral.
+ *
+ * The callback runs in the tick ISR, in series with every other tick client.
+ * It must therefore:
+ * - complete within 10 microseconds (roughly 1% of a 1 kHz tick)
+ * - not block, and only use the FromIsr variants of OS services
+ *
+ * Anything heavier belongs in a \ref DeferredCallbackTimer.
+ */
+class IsrCallbackTimer : public TimerBase {
+  public:
+    /**
+     * \brief Construct an ISR callback timer
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   callback        Callback invoked on expiry
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     */
+    IsrCallbackTimer(ITickSource &tick_source, IIsrTimerCallback &callback,
+            ICriticalErrorHandler &error_handler, IOsServices &os_services);
+
+    /**
+     * \brief Construct an ISR callback timer that belongs to a coalescing group
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   callback        Callback invoked on expiry
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     * \param[in]   group           Group to coalesce expiries with
+     */
+    IsrCallbackTimer(ITickSource &tick_source, IIsrTimerCallback &callback,
+            ICriticalErrorHandler &error_handler, IOsServices &os_services,
+            TimerCoalescingGroup &group);
+
+  private:
+    IIsrTimerCallback &callback_;
+
+    /**
+     * \brief See \ref TimerBase::OnExpiryFromIsr
+     */
+    virtual bool OnExpiryFromIsr(int reference, bool &task_woken) override;
+};
+
+}    // namespace djetk
+
+#endif    // ISR_CALLBACK_TIMER_H
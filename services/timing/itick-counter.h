@@ -0,0 +1,48 @@
+/**
+    \file
+    \brief Tick counter interface
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ITICK_COUNTER_H
+#define ITICK_COUNTER_H
+
+#include <cstdint>
+
+namespace djetk {
+
+/**
+ * \brief Interface to read the current time in ticks
+ *
+ * The count wraps around at 32 bits, so compare counts by their difference.
+ */
+class ITickCounter {
+  public:
+    /**
+     * \brief Get the number of ticks elapsed since some fixed point in time
+     */
+    virtual uint32_t GetTickCount() const = 0;
+
+    virtual ~ITickCounter() {}
+};
+
+}    // namespace djetk
+
+#endif    // ITICK_COUNTER_H
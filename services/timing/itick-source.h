@@ -51,6 +51,14 @@ class ITickSource {
      */
     virtual uint32_t MsToTicks(uint32_t milliseconds) = 0;
 
+    /**
+     * \brief Convert from FreeRTOS kernel ticks to ticks
+     * \param[in]   kernel_ticks    Value to convert to ticks
+     *
+     * Sources running at the FreeRTOS tick rate return the value unchanged.
+     */
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) = 0;
+
     virtual ~ITickSource() {}
 };
 
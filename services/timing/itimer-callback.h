@@ -0,0 +1,65 @@
+/**
+    \file
+    \brief Timer expiry callback interfaces
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ITIMER_CALLBACK_H
+#define ITIMER_CALLBACK_H
+
+namespace djetk {
+
+/**
+ * \brief Timer callback invoked from the tick ISR
+ *
+ * See \ref IsrCallbackTimer for the constraints on the implementation.
+ */
+class IIsrTimerCallback {
+  public:
+    /**
+     * \brief Callback to indicate the timer expired
+     * \param[in]   reference   Reference id given when the timer was started
+     * \param[out]  task_woken  Indicates if a thread reschedule is required
+     * \return true on success
+     */
+    virtual bool OnTimeoutFromIsr(int reference, bool &task_woken) = 0;
+
+    virtual ~IIsrTimerCallback() {}
+};
+
+/**
+ * \brief Timer callback invoked from the timer daemon task
+ *
+ * See \ref DeferredCallbackTimer and \ref TimerDaemon.
+ */
+class ITimerCallback {
+  public:
+    /**
+     * \brief Callback to indicate the timer expired
+     * \param[in]   reference   Reference id given when the timer was started
+     */
+    virtual void OnTimeout(int reference) = 0;
+
+    virtual ~ITimerCallback() {}
+};
+
+}    // namespace djetk
+
+#endif    // ITIMER_CALLBACK_H
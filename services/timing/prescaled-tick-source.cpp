@@ -0,0 +1,72 @@
+/**
+    \file
+    \brief Prescaled tick source implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <timing/prescaled-tick-source.h>
+
+namespace djetk {
+
+PrescaledTickSource::PrescaledTickSource(ITickSource &parent, uint32_t divider,
+        TickClientsList &clients_buffer, ICriticalErrorHandler &error_handler)
+    : parent_(parent),
+    clients_(clients_buffer, error_handler),
+    divider_(divider ? divider : 1),
+    count_(0)
+{
+    if (!parent_.RegisterTickClient(*this)) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
+                __FILE__, __LINE__);
+    }
+}
+
+bool PrescaledTickSource::RegisterTickClient(ITickClient &client)
+{
+    return clients_.Register(client);
+}
+
+uint32_t PrescaledTickSource::MsToTicks(uint32_t milliseconds)
+{
+    auto parent_ticks = parent_.MsToTicks(milliseconds);
+    return (parent_ticks / divider_) + ((parent_ticks % divider_) ? 1 : 0);
+}
+
+uint32_t PrescaledTickSource::KernelTicksToTicks(uint32_t kernel_ticks)
+{
+    auto parent_ticks = parent_.KernelTicksToTicks(kernel_ticks);
+    return (parent_ticks / divider_) + ((parent_ticks % divider_) ? 1 : 0);
+}
+
+bool PrescaledTickSource::OnTickFromIsr(bool &task_woken)
+{
+    count_++;
+    if (count_ < divider_) {
+        return true;
+    }
+
+    count_ = 0;
+    clients_.NotifyTickFromIsr(task_woken);
+
+    // Client failures are reported by the registry
+    return true;
+}
+
+}    // namespace djetk
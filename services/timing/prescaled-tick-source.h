@@ -0,0 +1,89 @@
+/**
+    \file
+    \brief Tick source notifying its clients on every Nth tick of a parent source
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PRESCALED_TICK_SOURCE_H
+#define PRESCALED_TICK_SOURCE_H
+
+#include <timing/itick-source.h>
+#include <timing/tick-client-registry.h>
+#include <errors/icritical-error-handler.h>
+
+namespace djetk {
+
+/**
+ * \brief Rate divided tick source
+ *
+ * Registers as a single client of a parent tick source and notifies its own
+ * clients on every Nth parent tick. Timers that only need a coarse resolution
+ * can be registered here so that the per tick ISR work of the parent only
+ * scales with the number of fine grained clients.
+ *
+ * - The resolution of the clients is N parent ticks. A timer started between
+ *   two prescaled ticks sees its first tick anywhere from 1 to N parent
+ *   ticks later.
+ * - \ref MsToTicks and \ref KernelTicksToTicks round up so that timeouts
+ *   don't elapse early by more than that phase error.
+ */
+class PrescaledTickSource : public ITickSource,
+                            private ITickClient {
+  public:
+    /**
+     * \brief Construct the tick source using the injected clients buffer
+     * \param[in]   parent          Tick source to divide
+     * \param[in]   divider         Number of parent ticks per tick
+     * \param[in]   clients_buffer  Buffer to store pointers to the registered clients
+     * \param[in]   error_handler   Callback reference to notify of errors
+     */
+    PrescaledTickSource(ITickSource &parent, uint32_t divider,
+            TickClientsList &clients_buffer, ICriticalErrorHandler &error_handler);
+
+    /**
+     * \brief See \ref ITickSource::RegisterTickClient
+     */
+    virtual bool RegisterTickClient(ITickClient &client) override;
+
+    /**
+     * \brief See \ref ITickSource::MsToTicks
+     */
+    virtual uint32_t MsToTicks(uint32_t milliseconds) override;
+
+    /**
+     * \brief See \ref ITickSource::KernelTicksToTicks
+     */
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) override;
+
+  private:
+    /**
+     * \brief See \ref ITickClient::OnTickFromIsr
+     */
+    virtual bool OnTickFromIsr(bool &task_woken) override;
+
+    ITickSource &parent_;
+    TickClientRegistry clients_;
+    uint32_t divider_;
+    uint32_t count_;
+};
+
+}    // namespace djetk
+
+#endif    // PRESCALED_TICK_SOURCE_H
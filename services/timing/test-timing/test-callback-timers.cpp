@@ -0,0 +1,155 @@
+/**
+    \file
+    \brief Callback timer tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/test-timing/test-callback-timers.h>
+#include <timing/isr-callback-timer.h>
+#include <timing/deferred-callback-timer.h>
+#include <testing/tick-generator-stub.h>
+#include <testing/message-queue-stub.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/os-services-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Timer callback stub recording the invocations
+ */
+class TimerCallbackStub : public IIsrTimerCallback,
+                          public ITimerCallback {
+  public:
+    TimerCallbackStub()
+        : call_count(0),
+        reference(0) {}
+
+    virtual bool OnTimeoutFromIsr(int reference_arg, bool &task_woken) override
+    {
+        call_count++;
+        reference = reference_arg;
+        task_woken = true;
+        return true;
+    }
+
+    virtual void OnTimeout(int reference_arg) override
+    {
+        call_count++;
+        reference = reference_arg;
+    }
+
+    /**
+     * \brief Number of times the callback was invoked
+     */
+    int call_count;
+
+    /**
+     * \brief Reference passed to the last invocation
+     */
+    int reference;
+};
+
+/**
+ * \test Test that an ISR callback timer invokes its callback on expiry
+ */
+void test_IsrCallbackTimer_TimerExpires_InvokesCallbackFromTick()
+{
+    TickGeneratorStub tick_source;
+    CriticalErrorHandlerStub error_handler;
+    OsServicesStub os_services;
+    TimerCallbackStub callback;
+    IsrCallbackTimer timer(tick_source, callback, error_handler, os_services);
+
+    static constexpr int kReference = 42;
+    timer.Start(2, kReference);
+
+    TEST_ASSERT_FALSE(tick_source.Tick());
+    TEST_ASSERT_EQUAL(0, callback.call_count);
+
+    // The task woken flag set by the callback is passed back to the tick source
+    TEST_ASSERT_TRUE(tick_source.Tick());
+    TEST_ASSERT_EQUAL(1, callback.call_count);
+    TEST_ASSERT_EQUAL(kReference, callback.reference);
+}
+
+/**
+ * \test Test that a deferred callback timer is handed to the daemon on expiry
+ */
+void test_DeferredCallbackTimer_TimerExpires_DaemonInvokesCallback()
+{
+    TickGeneratorStub tick_source;
+    CriticalErrorHandlerStub error_handler;
+    OsServicesStub os_services;
+    MessageQueueStub daemon_queue;
+    TimerDaemon daemon(daemon_queue);
+    TimerCallbackStub callback;
+    DeferredCallbackTimer timer(tick_source, daemon, callback, error_handler, os_services);
+
+    static constexpr int kReference = 7;
+    timer.Start(1, kReference);
+    tick_source.Tick();
+
+    // Nothing is invoked from the tick. The timer is queued up for the daemon.
+    TEST_ASSERT_EQUAL(0, callback.call_count);
+    TEST_ASSERT_EQUAL(1, daemon_queue.post_count);
+    TEST_ASSERT_TRUE(timer.IsExpiryPending());
+
+    // Once the daemon task gets to the message, the callback is invoked
+    TEST_ASSERT_TRUE(daemon.HandleMessage(daemon_queue.posted_msg));
+    TEST_ASSERT_EQUAL(1, callback.call_count);
+    TEST_ASSERT_EQUAL(kReference, callback.reference);
+    TEST_ASSERT_FALSE(timer.IsExpiryPending());
+}
+
+/**
+ * \test Test that destroying a deferred callback timer with an expiry queued
+ *       is reported rather than left to the daemon
+ */
+void test_DeferredCallbackTimer_DestroyedWithExpiryQueued_ReportsLifetimeError()
+{
+    TickGeneratorStub tick_source;
+    CriticalErrorHandlerStub error_handler;
+    OsServicesStub os_services;
+    MessageQueueStub daemon_queue;
+    TimerDaemon daemon(daemon_queue);
+    TimerCallbackStub callback;
+
+    {
+        DeferredCallbackTimer timer(tick_source, daemon, callback, error_handler, os_services);
+        timer.Start(1, 0);
+        tick_source.Tick();
+
+        // Stopping doesn't take back the queued expiry
+        timer.Stop();
+        TEST_ASSERT_TRUE(timer.IsExpiryPending());
+    }
+
+    TEST_ASSERT_TRUE(error_handler.is_critical_error);
+    TEST_ASSERT_EQUAL(ICriticalErrorHandler::lifetime_error, error_handler.last_error_code);
+
+    // A message without a timer is ignored
+    TEST_ASSERT_FALSE(daemon.HandleMessage(Message(0, static_cast<const void *>(nullptr))));
+    TEST_ASSERT_EQUAL(0, callback.call_count);
+}
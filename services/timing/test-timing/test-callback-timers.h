@@ -0,0 +1,43 @@
+/**
+    \file
+    \brief Callback timer tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEST_CALLBACK_TIMERS_H
+#define TEST_CALLBACK_TIMERS_H
+
+/**
+ * \test Test that an ISR callback timer invokes its callback on expiry
+ */
+void test_IsrCallbackTimer_TimerExpires_InvokesCallbackFromTick();
+
+/**
+ * \test Test that a deferred callback timer is handed to the daemon on expiry
+ */
+void test_DeferredCallbackTimer_TimerExpires_DaemonInvokesCallback();
+
+/**
+ * \test Test that destroying a deferred callback timer with an expiry queued
+ *       is reported rather than left to the daemon
+ */
+void test_DeferredCallbackTimer_DestroyedWithExpiryQueued_ReportsLifetimeError();
+
+#endif
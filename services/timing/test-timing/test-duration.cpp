@@ -0,0 +1,107 @@
+/**
+    \file
+    \brief Duration and tick conversion tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/test-timing/test-duration.h>
+#include <timing/freertos-duration.h>
+#include <timing/timer-object.h>
+#include <timing/prescaled-tick-source.h>
+#include <testing/tick-generator-stub.h>
+#include <testing/message-queue-stub.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/os-services-stub.h>
+
+using namespace djetk;
+using namespace djetk::literals;
+
+// Conversions are usable in constant expressions
+static_assert(Ticks(2_s).Count() == (2000 / portTICK_RATE_MS), "Seconds literal");
+static_assert(ToTicks<RoundDown>(0_ms).Count() == 0, "Zero duration");
+static_assert(Ticks::Infinite().Count() == portMAX_DELAY, "Infinite duration");
+
+/**
+ * \test Test the rounding policies used for millisecond to tick conversion
+ */
+void test_RoundingPolicies_PartialTicks_RoundAsSpecified()
+{
+    TEST_ASSERT_EQUAL(2, RoundDown::Divide(5, 2));
+    TEST_ASSERT_EQUAL(3, RoundUp::Divide(5, 2));
+    TEST_ASSERT_EQUAL(2, RoundUp::Divide(4, 2));
+    TEST_ASSERT_EQUAL(1, RoundNearest::Divide(4, 3));
+    TEST_ASSERT_EQUAL(2, RoundNearest::Divide(5, 3));
+}
+
+/**
+ * \test Test that a timer started with a duration expires after the converted tick count
+ */
+void test_Start_DurationLiteral_ExpiresAfterConvertedTicks()
+{
+    TickGeneratorStub tick_source;
+    MessageQueueStub message_queue;
+    CriticalErrorHandlerStub error_handler;
+    OsServicesStub os_services;
+    TimerObject timer(tick_source, message_queue, 1, error_handler, os_services);
+
+    static constexpr Ticks kTimeout = 5_ms;
+    timer.Start(kTimeout, 0);
+
+    for (uint32_t i = 1; i < kTimeout.Count(); i++) {
+        tick_source.Tick();
+    }
+    TEST_ASSERT_EQUAL(0, message_queue.post_count);
+
+    tick_source.Tick();
+    TEST_ASSERT_EQUAL(1, message_queue.post_count);
+}
+
+/**
+ * \test Test that a duration is converted through the tick source of the timer
+ */
+void test_Start_DurationOnPrescaledSource_ConvertedToPrescaledTicks()
+{
+    TickGeneratorStub parent;
+    std::array<ITickClient *, 1> clients;
+    TickClientsList client_list(clients.data(), clients.size());
+    CriticalErrorHandlerStub error_handler;
+    PrescaledTickSource tick_source(parent, 10, client_list, error_handler);
+    MessageQueueStub message_queue;
+    OsServicesStub os_services;
+    TimerObject timer(tick_source, message_queue, 1, error_handler, os_services);
+
+    // 25 kernel ticks round up to 3 prescaled ticks of 10 kernel ticks
+    timer.Start(Ticks(25), 0);
+
+    for (uint32_t i = 1; i < 30; i++) {
+        parent.Tick();
+    }
+    TEST_ASSERT_EQUAL(0, message_queue.post_count);
+
+    parent.Tick();
+    TEST_ASSERT_EQUAL(1, message_queue.post_count);
+}
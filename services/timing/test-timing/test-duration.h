@@ -0,0 +1,42 @@
+/**
+    \file
+    \brief Duration and tick conversion tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEST_DURATION_H
+#define TEST_DURATION_H
+
+/**
+ * \test Test the rounding policies used for millisecond to tick conversion
+ */
+void test_RoundingPolicies_PartialTicks_RoundAsSpecified();
+
+/**
+ * \test Test that a timer started with a duration expires after the converted tick count
+ */
+void test_Start_DurationLiteral_ExpiresAfterConvertedTicks();
+
+/**
+ * \test Test that a duration is converted through the tick source of the timer
+ */
+void test_Start_DurationOnPrescaledSource_ConvertedToPrescaledTicks();
+
+#endif
@@ -32,6 +32,7 @@ extern "C"
 #include <timing/test-timing/test-freertos-tick-hook-timer.h>
 #include <timing/timer-object.h>
 #include <testing/critical-error-handler-stub.h>
+#include <testing/cycle-counter-stub.h>
 
 using namespace djetk;
 
@@ -64,8 +65,12 @@ class TestFreeRTOSTickHookTimerContainer {
      * \brief Buffer where references to registered tick clients are held
      */
     std::array<ITickClient *, kTimerObjectCount> timer_objects;
-  private:
+
+    /**
+     * \brief Error handler notified of tick client errors
+     */
     CriticalErrorHandlerStub error_handler;
+  private:
     TickClientsList timer_object_list;
     FreeRTOSTickHookTimer freertos_tick_hook_timer;
 };
@@ -159,3 +164,48 @@ void test_FreeRTOSTickHook_ClientsRegistered_RegisteredClientsNotifiedOfTick()
     }
 }
 
+/**
+ * \test Test that enabling accounting fails if there are fewer statistics than clients
+ */
+void test_EnableAccounting_StatsBufferTooSmall_ReturnsFailureResult()
+{
+    TestFreeRTOSTickHookTimerContainer container;
+    CycleCounterStub cycle_counter;
+
+    std::array<ExecutionStats, container.kTimerObjectCount - 1> stats;
+    ExecutionStatsList stats_list(stats.data(), stats.size());
+
+    TEST_ASSERT_FALSE(container.GetTimer().EnableAccounting(cycle_counter, stats_list));
+}
+
+/**
+ * \test Test that the execution time of each client is recorded and overruns reported
+ *  - Each client appears to take 10 cycles
+ *  - The second client has a budget of 5 cycles
+ */
+void test_FreeRTOSTickHook_AccountingEnabled_RecordsClientsAndReportsOverruns()
+{
+    TestFreeRTOSTickHookTimerContainer container;
+    CycleCounterStub cycle_counter;
+    cycle_counter.step = 10;
+
+    std::array<ExecutionStats, container.kTimerObjectCount> stats;
+    ExecutionStatsList stats_list(stats.data(), stats.size());
+    stats[1].SetBudget(5);
+
+    std::array<TickClientStub, container.kTimerObjectCount - 1> tick_clients;
+    for (auto &client : tick_clients) {
+        container.GetTimer().RegisterTickClient(client);
+    }
+
+    TEST_ASSERT_TRUE(container.GetTimer().EnableAccounting(cycle_counter, stats_list));
+    vApplicationTickHook();
+
+    TEST_ASSERT_EQUAL(1, stats[0].GetCount());
+    TEST_ASSERT_EQUAL(10, stats[0].GetMax());
+    TEST_ASSERT_EQUAL(0, stats[0].GetOverrunCount());
+    TEST_ASSERT_EQUAL(1, stats[1].GetOverrunCount());
+    TEST_ASSERT_EQUAL(0, stats[2].GetCount());
+    TEST_ASSERT_EQUAL(ICriticalErrorHandler::isr_budget_error,
+        container.error_handler.last_error_code);
+}
@@ -27,6 +27,8 @@
 void test_RegisterTickClient_RegisteringToFullCapacity_SuccessfulResult();
 void test_RegisterTickClient_ClientBufferFull_ReturnsFailureResult();
 void test_FreeRTOSTickHook_ClientsRegistered_RegisteredClientsNotifiedOfTick();
+void test_EnableAccounting_StatsBufferTooSmall_ReturnsFailureResult();
+void test_FreeRTOSTickHook_AccountingEnabled_RecordsClientsAndReportsOverruns();
 
 #endif
 
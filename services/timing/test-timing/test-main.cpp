@@ -28,6 +28,21 @@ extern "C"
 
 #include <timing/test-timing/test-freertos-tick-hook-timer.h>
 #include <timing/test-timing/test-timing.h>
+#include <timing/test-timing/test-timer-coalescing-group.h>
+#include <timing/test-timing/test-callback-timers.h>
+#include <timing/test-timing/test-virtual-tick-source.h>
+#include <timing/test-timing/test-duration.h>
+#include <timing/test-timing/test-prescaled-tick-source.h>
+
+/**
+ * \brief FreeRTOS idle hook
+ *
+ * The scheduler isn't started by these tests, but the kernel pulled in by
+ * \ref djetk::VirtualTickSource references the hook.
+ */
+extern "C" void vApplicationIdleHook()
+{
+}
 
 /**
  * \brief Timer test entry point
@@ -49,6 +64,31 @@ int main()
     RUN_TEST(test_RegisterTickClient_RegisteringToFullCapacity_SuccessfulResult);
     RUN_TEST(test_RegisterTickClient_ClientBufferFull_ReturnsFailureResult);
     RUN_TEST(test_FreeRTOSTickHook_ClientsRegistered_RegisteredClientsNotifiedOfTick);
+    RUN_TEST(test_EnableAccounting_StatsBufferTooSmall_ReturnsFailureResult);
+    RUN_TEST(test_FreeRTOSTickHook_AccountingEnabled_RecordsClientsAndReportsOverruns);
+
+    // Test cases in test-timer-coalescing-group
+    RUN_TEST(test_Start_OverlappingSlackWindows_TimersExpireOnTheSameTick);
+    RUN_TEST(test_Start_ExpiryWithinSlackWindow_JoinsRunningTimer);
+    RUN_TEST(test_Start_DisjointSlackWindows_TimersExpireSeparately);
+
+    // Test cases in test-callback-timers
+    RUN_TEST(test_IsrCallbackTimer_TimerExpires_InvokesCallbackFromTick);
+    RUN_TEST(test_DeferredCallbackTimer_TimerExpires_DaemonInvokesCallback);
+    RUN_TEST(test_DeferredCallbackTimer_DestroyedWithExpiryQueued_ReportsLifetimeError);
+
+    // Test cases in test-virtual-tick-source
+    RUN_TEST(test_Step_TenMinuteTimeout_ExpiresOnTheExpectedTick);
+    RUN_TEST(test_OnIdle_AdvancesClockByOneTick);
+
+    // Test cases in test-duration
+    RUN_TEST(test_RoundingPolicies_PartialTicks_RoundAsSpecified);
+    RUN_TEST(test_Start_DurationLiteral_ExpiresAfterConvertedTicks);
+    RUN_TEST(test_Start_DurationOnPrescaledSource_ConvertedToPrescaledTicks);
+
+    // Test cases in test-prescaled-tick-source
+    RUN_TEST(test_OnTickFromIsr_ParentTicks_ClientsNotifiedEveryNthTick);
+    RUN_TEST(test_MsToTicks_PartialPrescaledTick_RoundsUp);
 
     return UnityEnd();
 }
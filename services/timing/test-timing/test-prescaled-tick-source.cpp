@@ -0,0 +1,118 @@
+/**
+    \file
+    \brief Prescaled tick source tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/test-timing/test-prescaled-tick-source.h>
+#include <timing/prescaled-tick-source.h>
+#include <testing/tick-generator-stub.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Tick client counting the notifications
+ */
+class CountingTickClientStub : public ITickClient {
+  public:
+    CountingTickClientStub()
+        : tick_count(0) {}
+
+    virtual bool OnTickFromIsr(bool &task_woken) override
+    {
+        (void)task_woken;
+        tick_count++;
+        return true;
+    }
+
+    /**
+     * \brief Number of tick notifications
+     */
+    int tick_count;
+};
+
+/**
+    \brief Container class to construct the PrescaledTickSource
+*/
+class TestPrescaledTickSourceContainer {
+  public:
+    TestPrescaledTickSourceContainer()
+        : client_list(clients.data(), clients.size()),
+        tick_source(parent, kDivider, client_list, error_handler)
+    {
+    }
+
+    /**
+     * \privatesection Test container injected stubs
+     */
+    static constexpr uint32_t kDivider = 10;
+    TickGeneratorStub parent;
+    std::array<ITickClient *, 2> clients;
+    TickClientsList client_list;
+    CriticalErrorHandlerStub error_handler;
+    PrescaledTickSource tick_source;
+};
+
+/**
+ * \test Test that clients are only notified on every Nth parent tick
+ */
+void test_OnTickFromIsr_ParentTicks_ClientsNotifiedEveryNthTick()
+{
+    TestPrescaledTickSourceContainer container;
+    CountingTickClientStub client;
+    TEST_ASSERT_TRUE(container.tick_source.RegisterTickClient(client));
+
+    // Only the prescaler is registered with the parent
+    TEST_ASSERT_EQUAL(1, container.parent.client_count);
+
+    for (uint32_t i = 0; i < (container.kDivider - 1); i++) {
+        container.parent.Tick();
+    }
+    TEST_ASSERT_EQUAL(0, client.tick_count);
+
+    container.parent.Tick();
+    TEST_ASSERT_EQUAL(1, client.tick_count);
+
+    for (uint32_t i = 0; i < (container.kDivider * 2); i++) {
+        container.parent.Tick();
+    }
+    TEST_ASSERT_EQUAL(3, client.tick_count);
+}
+
+/**
+ * \test Test that millisecond conversions round up to the next prescaled tick
+ */
+void test_MsToTicks_PartialPrescaledTick_RoundsUp()
+{
+    TestPrescaledTickSourceContainer container;
+
+    // The parent stub converts 1 ms to 1 tick
+    TEST_ASSERT_EQUAL(1, container.tick_source.MsToTicks(10));
+    TEST_ASSERT_EQUAL(2, container.tick_source.MsToTicks(15));
+    TEST_ASSERT_EQUAL(0, container.tick_source.MsToTicks(0));
+}
@@ -0,0 +1,37 @@
+/**
+    \file
+    \brief Prescaled tick source tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEST_PRESCALED_TICK_SOURCE_H
+#define TEST_PRESCALED_TICK_SOURCE_H
+
+/**
+ * \test Test that clients are only notified on every Nth parent tick
+ */
+void test_OnTickFromIsr_ParentTicks_ClientsNotifiedEveryNthTick();
+
+/**
+ * \test Test that millisecond conversions round up to the next prescaled tick
+ */
+void test_MsToTicks_PartialPrescaledTick_RoundsUp();
+
+#endif
@@ -0,0 +1,133 @@
+/**
+    \file
+    \brief Timer coalescing group tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/test-timing/test-timer-coalescing-group.h>
+#include <timing/timer-coalescing-group.h>
+#include <timing/timer-object.h>
+#include <testing/tick-generator-stub.h>
+#include <testing/message-queue-stub.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/os-services-stub.h>
+
+using namespace djetk;
+
+/**
+    \brief Container class to construct a group of two timers
+*/
+class TestTimerCoalescingGroupContainer {
+  public:
+    TestTimerCoalescingGroupContainer()
+        : group(tick_source, error_handler),
+        timer_a(tick_source, message_queue, kMessageIdA, error_handler, os_services, group),
+        timer_b(tick_source, message_queue, kMessageIdB, error_handler, os_services, group)
+    {
+    }
+
+    /**
+     * \brief Generate ticks until a timeout message is posted
+     * \param[in]   max_ticks   Maximum number of ticks to generate
+     * \return Number of ticks generated
+     */
+    uint32_t TickUntilPosted(uint32_t max_ticks)
+    {
+        auto post_count = message_queue.post_count;
+        uint32_t ticks = 0;
+        while ((message_queue.post_count == post_count) && (ticks < max_ticks)) {
+            tick_source.Tick();
+            ticks++;
+        }
+
+        return ticks;
+    }
+
+    /**
+     * \privatesection Test container injected stubs
+     */
+    TickGeneratorStub tick_source;
+    MessageQueueStub message_queue;
+    CriticalErrorHandlerStub error_handler;
+    OsServicesStub os_services;
+    TimerCoalescingGroup group;
+    TimerObject timer_a;
+    TimerObject timer_b;
+    static constexpr uint32_t kMessageIdA = 0x1234;
+    static constexpr uint32_t kMessageIdB = 0x5678;
+};
+
+/**
+ * \test Test that timers with overlapping slack windows expire on the same tick
+ */
+void test_Start_OverlappingSlackWindows_TimersExpireOnTheSameTick()
+{
+    TestTimerCoalescingGroupContainer container;
+
+    // Timer A may expire anywhere between 10 and 15 ticks. Timer B has no
+    // slack and expires at 12 which falls within A's window.
+    container.timer_a.Start(10, 1, 5);
+    container.timer_b.Start(12, 2);
+
+    TEST_ASSERT_EQUAL(12, container.TickUntilPosted(100));
+    TEST_ASSERT_EQUAL(2, container.message_queue.post_count);
+    TEST_ASSERT_EQUAL(2, container.group.GetExpiryCount());
+    TEST_ASSERT_EQUAL(1, container.group.GetWakeupsSaved());
+}
+
+/**
+ * \test Test that a timer with slack joins a running timer expiring within its window
+ */
+void test_Start_ExpiryWithinSlackWindow_JoinsRunningTimer()
+{
+    TestTimerCoalescingGroupContainer container;
+
+    // Timer B's window of 5 to 15 ticks contains A's expiry
+    container.timer_a.Start(10, 1);
+    container.timer_b.Start(5, 2, 10);
+
+    TEST_ASSERT_EQUAL(10, container.TickUntilPosted(100));
+    TEST_ASSERT_EQUAL(2, container.message_queue.post_count);
+    TEST_ASSERT_EQUAL(1, container.group.GetWakeupsSaved());
+}
+
+/**
+ * \test Test that timers with disjoint windows aren't coalesced
+ */
+void test_Start_DisjointSlackWindows_TimersExpireSeparately()
+{
+    TestTimerCoalescingGroupContainer container;
+
+    // A lone timer expires at the end of its window
+    container.timer_a.Start(10, 1, 2);
+    container.timer_b.Start(20, 2, 0);
+
+    TEST_ASSERT_EQUAL(12, container.TickUntilPosted(100));
+    TEST_ASSERT_EQUAL(container.kMessageIdA, container.message_queue.posted_msg.id);
+    TEST_ASSERT_EQUAL(8, container.TickUntilPosted(100));
+    TEST_ASSERT_EQUAL(container.kMessageIdB, container.message_queue.posted_msg.id);
+    TEST_ASSERT_EQUAL(2, container.group.GetExpiryCount());
+    TEST_ASSERT_EQUAL(0, container.group.GetWakeupsSaved());
+}
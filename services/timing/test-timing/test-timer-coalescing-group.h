@@ -0,0 +1,42 @@
+/**
+    \file
+    \brief Timer coalescing group tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TEST_TIMER_COALESCING_GROUP_H
+#define TEST_TIMER_COALESCING_GROUP_H
+
+/**
+ * \test Test that timers with overlapping slack windows expire on the same tick
+ */
+void test_Start_OverlappingSlackWindows_TimersExpireOnTheSameTick();
+
+/**
+ * \test Test that a timer with slack joins a running timer expiring within its window
+ */
+void test_Start_ExpiryWithinSlackWindow_JoinsRunningTimer();
+
+/**
+ * \test Test that timers with disjoint windows aren't coalesced
+ */
+void test_Start_DisjointSlackWindows_TimersExpireSeparately();
+
+#endif
@@ -36,6 +36,11 @@ class TickSourceStub : public ITickSource {
         return ms_to_ticks_result;
     }
 
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) override
+    {
+        return kernel_ticks;
+    }
+
     /**
      * \privatesection Stub result/injected data
      */
@@ -0,0 +1,101 @@
+/**
+    \file
+    \brief Virtual tick source tests
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/test-timing/test-virtual-tick-source.h>
+#include <timing/virtual-tick-source.h>
+#include <timing/timer-object.h>
+#include <testing/message-queue-stub.h>
+#include <testing/critical-error-handler-stub.h>
+#include <testing/os-services-stub.h>
+
+using namespace djetk;
+
+/**
+    \brief Container class to construct the VirtualTickSource with a timer
+*/
+class TestVirtualTickSourceContainer {
+  public:
+    TestVirtualTickSourceContainer()
+        : client_list(clients.data(), clients.size()),
+        tick_source(client_list, error_handler),
+        timer(tick_source, message_queue, kMessageId, error_handler, os_services)
+    {
+    }
+
+    /**
+     * \privatesection Test container injected stubs
+     */
+    std::array<ITickClient *, 1> clients;
+    TickClientsList client_list;
+    CriticalErrorHandlerStub error_handler;
+    MessageQueueStub message_queue;
+    OsServicesStub os_services;
+    VirtualTickSource tick_source;
+    TimerObject timer;
+    static constexpr uint32_t kMessageId = 0x1234;
+};
+
+/**
+ * \test Test that a long timeout expires exactly when the virtual clock gets there
+ */
+void test_Step_TenMinuteTimeout_ExpiresOnTheExpectedTick()
+{
+    TestVirtualTickSourceContainer container;
+
+    static constexpr uint32_t kTenMinutesMs = 10 * 60 * 1000;
+    container.timer.Start(kTenMinutesMs, 1);
+
+    container.tick_source.Step(kTenMinutesMs - 1);
+    TEST_ASSERT_EQUAL(0, container.message_queue.post_count);
+
+    container.tick_source.Step();
+    TEST_ASSERT_EQUAL(1, container.message_queue.post_count);
+    TEST_ASSERT_EQUAL(container.kMessageId, container.message_queue.posted_msg.id);
+    TEST_ASSERT_EQUAL(kTenMinutesMs, container.tick_source.GetTickCount());
+}
+
+/**
+ * \test Test that each idle callback advances the clock by one tick
+ */
+void test_OnIdle_AdvancesClockByOneTick()
+{
+    TestVirtualTickSourceContainer container;
+
+    container.timer.Start(2, 1);
+    IIdleHandler &idle_handler = container.tick_source;
+
+    idle_handler.OnIdle();
+    TEST_ASSERT_EQUAL(1, container.tick_source.GetTickCount());
+    TEST_ASSERT_EQUAL(0, container.message_queue.post_count);
+
+    idle_handler.OnIdle();
+    TEST_ASSERT_EQUAL(2, container.tick_source.GetTickCount());
+    TEST_ASSERT_EQUAL(1, container.message_queue.post_count);
+}
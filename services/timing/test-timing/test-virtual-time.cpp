@@ -0,0 +1,140 @@
+/**
+    \file
+    \brief Virtual tick source tests under the scheduler
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+
+extern "C"
+{
+#include <unity.h>
+}
+
+#include <timing/virtual-tick-source.h>
+#include <timing/timer-object.h>
+#include <timing/freertos-ticks.h>
+#include <threads/freertos-task-base.h>
+#include <threads/freertos-scheduler.h>
+#include <messaging/freertos-queue.h>
+#include <os/freertos-os-services.h>
+#include <testing/critical-error-handler-stub.h>
+
+using namespace djetk;
+
+/**
+ * \brief Virtual timeout of the test timer (one minute at 1 ms per tick)
+ */
+static constexpr uint32_t kTimeoutMs = 60000;
+
+/**
+ * \brief Task that waits for a timer on the virtual tick source
+ *
+ * The task blocks on the timer's queue without a timeout, so the idle task
+ * runs and advances the virtual clock until the timer expires.
+ */
+class VirtualTimerTask : public FreeRTOSTaskBase {
+  public:
+    VirtualTimerTask(ICriticalErrorHandler &error_handler, FreeRTOSScheduler &scheduler,
+            VirtualTickSource &tick_source, TimerObject &timer, FreeRTOSQueue &queue)
+    : FreeRTOSTaskBase(error_handler, reinterpret_cast<const signed char *>("VIRTUAL"),
+            configMINIMAL_STACK_SIZE * 4, tskIDLE_PRIORITY + 1),
+    received(false),
+    virtual_ticks(0),
+    kernel_ticks(0),
+    scheduler_(scheduler),
+    tick_source_(tick_source),
+    timer_(timer),
+    queue_(queue)
+    {
+    }
+
+    /**
+     * \brief Set if the timeout message was received
+     */
+    bool received;
+
+    /**
+     * \brief Virtual ticks elapsed when the timeout message was received
+     */
+    uint32_t virtual_ticks;
+
+    /**
+     * \brief Kernel ticks elapsed while waiting for the timeout message
+     */
+    portTickType kernel_ticks;
+
+ private:
+    virtual void TaskMain()
+    {
+        auto start = xTaskGetTickCount();
+        timer_.Start(kTimeoutMs, 0);
+
+        Message msg;
+        received = queue_.ReceiveMessage(infinite_ms, msg);
+        virtual_ticks = tick_source_.GetTickCount();
+        kernel_ticks = xTaskGetTickCount() - start;
+
+        scheduler_.Stop();
+    }
+
+    FreeRTOSScheduler &scheduler_;
+    VirtualTickSource &tick_source_;
+    TimerObject &timer_;
+    FreeRTOSQueue &queue_;
+};
+
+/**
+ * \test Test that a timer on the virtual tick source driven from the idle
+ *       hook expires on its virtual tick, well ahead of real time
+ *
+ * The scheduler can only be started once, so this runs in an app of its own.
+ */
+void test_RegisterIdleHandler_TaskBlockedOnTimer_VirtualTimeRunsAhead()
+{
+    auto &scheduler = FreeRTOSScheduler::GetScheduler();
+    CriticalErrorHandlerStub error_handler;
+    FreeRTOSOsServices os_services;
+    std::array<ITickClient *, 1> clients;
+    TickClientsList client_list(clients.data(), clients.size());
+    VirtualTickSource tick_source(client_list, error_handler);
+    FreeRTOSQueue queue(1, error_handler);
+    TimerObject timer(tick_source, queue, 1, error_handler, os_services);
+    VirtualTimerTask task(error_handler, scheduler, tick_source, timer, queue);
+
+    TEST_ASSERT_TRUE(scheduler.RegisterIdleHandler(tick_source));
+    scheduler.Start();
+    scheduler.UnregisterIdleHandler();
+
+    TEST_ASSERT_FALSE(error_handler.is_critical_error);
+    TEST_ASSERT_TRUE(task.received);
+    TEST_ASSERT_EQUAL(kTimeoutMs, task.virtual_ticks);
+    TEST_ASSERT_TRUE(task.kernel_ticks < (kTimeoutMs / portTICK_RATE_MS));
+}
+
+/**
+ * \brief Main entry point for test
+ */
+int main()
+{
+    UnityBegin(__FILE__);
+    RUN_TEST(test_RegisterIdleHandler_TaskBlockedOnTimer_VirtualTimeRunsAhead);
+    return UnityEnd();
+}
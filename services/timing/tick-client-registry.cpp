@@ -0,0 +1,89 @@
+/**
+    \file
+    \brief Tick client registry implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <timing/tick-client-registry.h>
+
+namespace djetk {
+
+TickClientRegistry::TickClientRegistry(TickClientsList &clients_buffer,
+        ICriticalErrorHandler &error_handler)
+    : clients_buffer_(clients_buffer),
+    last_registered_client_(clients_buffer.begin()),
+    error_handler_(error_handler),
+    cycle_counter_(nullptr),
+    stats_(nullptr)
+{
+}
+
+bool TickClientRegistry::Register(ITickClient &client)
+{
+    // Register the client if the buffer is not full
+    if (last_registered_client_ == clients_buffer_.end()) {
+        return false;
+    }
+
+    *last_registered_client_= &client;
+    last_registered_client_++;
+    return true;
+}
+
+void TickClientRegistry::NotifyTickFromIsr(bool &task_woken)
+{
+    // Notify all the registered tick clients that a tick event has occurred
+    for (auto it = clients_buffer_.begin(); it != last_registered_client_; it++) {
+        bool result;
+        if (cycle_counter_ == nullptr) {
+            result = (*it)->OnTickFromIsr(task_woken);
+        } else {
+            auto start = cycle_counter_->GetCycles();
+            result = (*it)->OnTickFromIsr(task_woken);
+            auto elapsed = cycle_counter_->GetCycles() - start;
+
+            auto &stats = stats_->data()[it - clients_buffer_.begin()];
+            if (!stats.Record(elapsed)) {
+                error_handler_.NotifyCriticalError(ICriticalErrorHandler::isr_budget_error,
+                    __FILE__, __LINE__);
+            }
+        }
+
+        // Notify error handler if failed to write to queue
+        if (!result) {
+            error_handler_.NotifyCriticalError(ICriticalErrorHandler::isr_handler_error,
+                __FILE__, __LINE__);
+        }
+    }
+}
+
+bool TickClientRegistry::EnableAccounting(ICycleCounter &cycle_counter,
+        ExecutionStatsList &stats)
+{
+    if (stats.size() < clients_buffer_.size()) {
+        return false;
+    }
+
+    stats_ = &stats;
+    cycle_counter_ = &cycle_counter;
+    return true;
+}
+
+}    // namespace djetk
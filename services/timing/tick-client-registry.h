@@ -0,0 +1,104 @@
+/**
+    \file
+    \brief Registry of tick clients notified by a tick source
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TICK_CLIENT_REGISTRY_H
+#define TICK_CLIENT_REGISTRY_H
+
+#include <timing/itick-client.h>
+#include <utilities/buffptr.h>
+#include <errors/icritical-error-handler.h>
+#include <profiling/icycle-counter.h>
+#include <profiling/execution-stats.h>
+
+namespace djetk {
+
+// typedef of tick client pointer list to make it easier to use later on
+/**
+ * \brief Buffer pointer to a list (array) of tick clients
+ */
+typedef buffptr<ITickClient*> TickClientsList;
+
+/**
+ * \brief List of registered tick clients
+ *
+ * Common implementation for tick sources to keep track of their clients and
+ * notify them of ticks.
+ * - Requires a buffer to be injected during construction. This buffer is contains the
+ *   list of registered clients. This means the creator has to allocate a big enough
+ *   buffer for all the timers.
+ * - Clients are notified in registration order
+ * - Interrupts are not disabled during registration (this is assumed to occur before
+ *   the scheduler is started)
+ */
+class TickClientRegistry {
+  public:
+    /**
+     * \brief Construct the registry using the injected clients buffer
+     * \param[in]   clients_buffer  Buffer to store pointers to the registered clients
+     * \param[in]   error_handler   Callback reference to notify of client errors
+     *
+     * This class reads from and writes the clients buffer, but does not take owener
+     * ship of the memory
+     */
+    TickClientRegistry(TickClientsList &clients_buffer, ICriticalErrorHandler &error_handler);
+
+    /**
+     * \brief Register a tick client
+     * \param[in]   client  Reference to a tick client
+     * \return true if successful, false if the buffer is full
+     */
+    bool Register(ITickClient &client);
+
+    /**
+     * \brief Notify all the registered clients of a tick event
+     * \param[out]  task_woken  Indicates if a thread reschedule is required
+     *
+     * Client failures are notified to the error handler.
+     */
+    void NotifyTickFromIsr(bool &task_woken);
+
+    /**
+     * \brief Measure the execution time of each client
+     * \param[in]   cycle_counter   Clock to measure the execution times with
+     * \param[in]   stats           Statistics of each client. The entry at a
+     *              given index belongs to the client at the same index of the
+     *              clients buffer (i.e. in registration order).
+     * \return false if the statistics buffer is smaller than the clients buffer
+     *
+     * A client exceeding the budget set in its statistics is reported to the
+     * error handler with ICriticalErrorHandler::isr_budget_error. This is to be
+     * invoked before the scheduler starts.
+     */
+    bool EnableAccounting(ICycleCounter &cycle_counter, ExecutionStatsList &stats);
+
+  private:
+    TickClientsList &clients_buffer_;
+    TickClientsList::iterator last_registered_client_;
+    ICriticalErrorHandler &error_handler_;
+    ICycleCounter *cycle_counter_;
+    ExecutionStatsList *stats_;
+};
+
+}    // namespace djetk
+
+#endif    // TICK_CLIENT_REGISTRY_H
@@ -0,0 +1,139 @@
+/**
+    \file
+    \brief Timer base class implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <timing/timer-base.h>
+
+namespace djetk {
+
+TimerBase::TimerBase(ITickSource &tick_source, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services)
+    : tick_source_(tick_source),
+    os_services_(os_services),
+    reference_(0),
+    started_(false),
+    ticks_remaining_(0),
+    group_(nullptr),
+    next_in_group_(nullptr),
+    slack_remaining_(0)
+{
+    if (!tick_source.RegisterTickClient(*this)) {
+        // Normally this function doesn't return, but during unit testing it
+        // does so break out after calling it.
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
+                __FILE__, __LINE__);
+        return;
+    }
+}
+
+TimerBase::TimerBase(ITickSource &tick_source, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group)
+    : TimerBase(tick_source, error_handler, os_services)
+{
+    group_ = &group;
+    group_->AddTimer(*this);
+}
+
+TimerBase::~TimerBase()
+{
+    // TODO Unregister from the tick source
+    if (group_) {
+        AutoInterruptDisabler disabler(os_services_);
+        group_->RemoveTimer(*this);
+    }
+}
+
+void TimerBase::Start(uint32_t timeout_ms, int reference)
+{
+    Start(timeout_ms, reference, 0);
+}
+
+void TimerBase::Start(uint32_t timeout_ms, int reference, uint32_t slack_ms)
+{
+    auto ticks = tick_source_.MsToTicks(timeout_ms);
+    if (!ticks) {
+        ticks++;
+    }
+
+    auto slack_ticks = slack_ms ? tick_source_.MsToTicks(slack_ms) : 0;
+    StartTicks(ticks, reference, slack_ticks);
+}
+
+void TimerBase::Start(Ticks timeout, int reference)
+{
+    Start(timeout, reference, Ticks(0));
+}
+
+void TimerBase::Start(Ticks timeout, int reference, Ticks slack)
+{
+    auto ticks = tick_source_.KernelTicksToTicks(timeout.Count());
+    if (!ticks) {
+        ticks++;
+    }
+
+    auto slack_ticks = slack.Count() ? tick_source_.KernelTicksToTicks(slack.Count()) : 0;
+    StartTicks(ticks, reference, slack_ticks);
+}
+
+void TimerBase::StartTicks(uint32_t ticks, int reference, uint32_t slack_ticks)
+{
+    // Nested block has interrupts disabled
+    {
+        AutoInterruptDisabler disabler(os_services_);
+        reference_ = reference;
+        started_ = true;
+        if (group_) {
+            group_->Schedule(*this, ticks, slack_ticks);
+        } else {
+            ticks_remaining_ = ticks;
+            slack_remaining_ = 0;
+        }
+    }
+}
+
+void TimerBase::Stop()
+{
+    AutoInterruptDisabler disabler(os_services_);
+    started_ = false;
+}
+
+bool TimerBase::OnTickFromIsr(bool &task_woken)
+{
+    if (!started_) {
+        return true;
+    }
+
+    ticks_remaining_--;
+    if (ticks_remaining_) {
+        return true;
+    }
+
+    // Stop the timer
+    started_ = false;
+    if (group_) {
+        group_->NotifyExpiryFromIsr();
+    }
+
+    return OnExpiryFromIsr(reference_, task_woken);
+}
+
+}    // namespace djetk
@@ -0,0 +1,177 @@
+/**
+    \file
+    \brief Timer base class definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMER_BASE_H
+#define TIMER_BASE_H
+
+#include <timing/itick-client.h>
+#include <timing/itick-source.h>
+#include <timing/timer-coalescing-group.h>
+#include <timing/freertos-duration.h>
+#include <errors/icritical-error-handler.h>
+#include <os/ios-services.h>
+
+namespace djetk {
+
+/**
+ * \brief Timer base class
+ *  - Listens to tick events from an injected tick source and counts down
+ *    to the expiry of the timer
+ *  - Expects ticks to originate from ISR context
+ *  - Start/Stop operations disable interrupts temporarily
+ *
+ * Derived classes define what happens on expiry by implementing
+ * \ref OnExpiryFromIsr.
+ */
+class TimerBase : private ITickClient {
+  public:
+    /**
+     * \brief Construct a timer
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     *
+     * Registers to the injected tick source during construction. Any
+     * errors during construction are communicated via the error handler
+     */
+    TimerBase(ITickSource &tick_source, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services);
+
+    /**
+     * \brief Construct a timer that belongs to a coalescing group
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     * \param[in]   group           Group to coalesce expiries with. It must
+     *              be registered to the same tick source.
+     *
+     * See \ref TimerCoalescingGroup for details on how the slack given to
+     * \ref Start is used.
+     */
+    TimerBase(ITickSource &tick_source, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group);
+
+    virtual ~TimerBase();
+
+    /**
+     * \brief (Re)Start the timer
+     * \param[in]   timeout_ms  Timeout period in milliseconds
+     * \param[in]   reference   Application specific reference id
+     *
+     * Start the timer if not already running. If the timer is running, it's
+     * re-started. The reference number is handed to \ref OnExpiryFromIsr
+     * when the timer expires. This allows the client to avoid a race that
+     * can occur when a timeout event is pending when the Stop method is
+     * invoked.
+     *
+     * \note if the timeout_ms never converts to 0 ticks. At-least 1 system
+     * tick is guaranteed.
+     */
+    void Start(uint32_t timeout_ms, int reference);
+
+    /**
+     * \brief (Re)Start the timer with a tolerance on the expiry time
+     * \param[in]   timeout_ms  Timeout period in milliseconds
+     * \param[in]   reference   Application specific reference id
+     * \param[in]   slack_ms    Period in milliseconds by which the expiry may
+     *              be delayed
+     *
+     * Same as \ref Start(uint32_t, int), except the timer may expire any time
+     * up to slack_ms after the timeout. This allows the expiry to be batched
+     * with the other timers of the \ref TimerCoalescingGroup the timer belongs
+     * to. The slack is ignored if the timer doesn't belong to a group.
+     */
+    void Start(uint32_t timeout_ms, int reference, uint32_t slack_ms);
+
+    /**
+     * \brief (Re)Start the timer with a timeout in kernel ticks
+     * \param[in]   timeout     Timeout period (e.g. 250_ms)
+     * \param[in]   reference   Application specific reference id
+     *
+     * Same as \ref Start(uint32_t, int), except the milliseconds are
+     * converted to kernel ticks at compile time. The kernel ticks are then
+     * converted through \ref ITickSource::KernelTicksToTicks, which is free
+     * for tick sources running at the FreeRTOS tick rate.
+     */
+    void Start(Ticks timeout, int reference);
+
+    /**
+     * \brief (Re)Start the timer with a timeout and slack in kernel ticks
+     * \param[in]   timeout     Timeout period (e.g. 250_ms)
+     * \param[in]   reference   Application specific reference id
+     * \param[in]   slack       Period by which the expiry may be delayed
+     *
+     * See \ref Start(uint32_t, int, uint32_t) and \ref Start(Ticks, int).
+     */
+    void Start(Ticks timeout, int reference, Ticks slack);
+
+    /**
+     * \brief Stop the timer if it's started
+     */
+    void Stop();
+
+  private:
+    friend class TimerCoalescingGroup;
+
+    /**
+     * \brief Common implementation of the Start methods
+     * \param[in]   ticks       Timeout period in ticks
+     * \param[in]   reference   Application specific reference id
+     * \param[in]   slack_ticks Slack in ticks
+     */
+    void StartTicks(uint32_t ticks, int reference, uint32_t slack_ticks);
+
+    /**
+     * \brief Act on the expiry of the timer
+     * \param[in]   reference   Reference id given when the timer was started
+     * \param[out]  task_woken  Indicates if a thread reschedule is required
+     * \return true on success
+     *
+     * Invoked from the tick ISR.
+     */
+    virtual bool OnExpiryFromIsr(int reference, bool &task_woken) = 0;
+
+    ITickSource &tick_source_;
+    IOsServices &os_services_;
+    int reference_;
+    bool started_;
+    uint32_t ticks_remaining_;
+
+    // Coalescing group membership. slack_remaining_ is the number of ticks
+    // the expiry can still be brought forward by.
+    TimerCoalescingGroup *group_;
+    TimerBase *next_in_group_;
+    uint32_t slack_remaining_;
+
+    // ITickClient interface implementation is private so that only the service
+    // that the interface is exposed only to the service that this object registers
+    // with.
+    /**
+     * \brief See \ref ITickClient::OnTickFromIsr
+     */
+    virtual bool OnTickFromIsr(bool &task_woken) override;
+};
+
+}    // namespace djetk
+
+#endif    // TIMER_BASE_H
@@ -0,0 +1,122 @@
+/**
+    \file
+    \brief Timer coalescing group implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <limits>
+#include <timing/timer-coalescing-group.h>
+#include <timing/timer-base.h>
+
+namespace djetk {
+
+TimerCoalescingGroup::TimerCoalescingGroup(ITickSource &tick_source,
+        ICriticalErrorHandler &error_handler)
+    : timers_(nullptr),
+    expired_this_tick_(false),
+    expiry_count_(0),
+    wakeups_saved_(0)
+{
+    if (!tick_source.RegisterTickClient(*this)) {
+        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
+                __FILE__, __LINE__);
+    }
+}
+
+void TimerCoalescingGroup::AddTimer(TimerBase &timer)
+{
+    timer.next_in_group_ = timers_;
+    timers_ = &timer;
+}
+
+void TimerCoalescingGroup::RemoveTimer(TimerBase &timer)
+{
+    for (auto link = &timers_; *link != nullptr; link = &(*link)->next_in_group_) {
+        if (*link == &timer) {
+            *link = timer.next_in_group_;
+            return;
+        }
+    }
+}
+
+void TimerCoalescingGroup::Schedule(TimerBase &timer, uint32_t ticks, uint32_t slack_ticks)
+{
+    auto latest = ticks + slack_ticks;
+    if (latest < ticks) {
+        latest = std::numeric_limits<uint32_t>::max();
+    }
+
+    // Join the earliest timer that already expires within our window
+    TimerBase *match = nullptr;
+    for (auto other = timers_; other != nullptr; other = other->next_in_group_) {
+        if ((other == &timer) || !other->started_) {
+            continue;
+        }
+
+        auto remaining = other->ticks_remaining_;
+        if ((remaining >= ticks) && (remaining <= latest)) {
+            if ((match == nullptr) || (remaining < match->ticks_remaining_)) {
+                match = other;
+            }
+        }
+    }
+
+    if (match != nullptr) {
+        timer.ticks_remaining_ = match->ticks_remaining_;
+        timer.slack_remaining_ = match->ticks_remaining_ - ticks;
+        return;
+    }
+
+    // Nothing to join, so expire as late as allowed. Timers expiring later
+    // than that whose window reaches back to it are pulled in.
+    timer.ticks_remaining_ = latest;
+    timer.slack_remaining_ = latest - ticks;
+
+    for (auto other = timers_; other != nullptr; other = other->next_in_group_) {
+        if ((other == &timer) || !other->started_) {
+            continue;
+        }
+
+        auto remaining = other->ticks_remaining_;
+        if ((remaining > latest) && ((remaining - other->slack_remaining_) <= latest)) {
+            other->slack_remaining_ -= remaining - latest;
+            other->ticks_remaining_ = latest;
+        }
+    }
+}
+
+void TimerCoalescingGroup::NotifyExpiryFromIsr()
+{
+    expiry_count_++;
+    if (expired_this_tick_) {
+        wakeups_saved_++;
+    }
+
+    expired_this_tick_ = true;
+}
+
+bool TimerCoalescingGroup::OnTickFromIsr(bool &task_woken)
+{
+    (void)task_woken;
+    expired_this_tick_ = false;
+    return true;
+}
+
+}    // namespace djetk
@@ -0,0 +1,125 @@
+/**
+    \file
+    \brief Timer coalescing group definition
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TIMER_COALESCING_GROUP_H
+#define TIMER_COALESCING_GROUP_H
+
+#include <cstdint>
+#include <timing/itick-client.h>
+#include <timing/itick-source.h>
+#include <errors/icritical-error-handler.h>
+
+namespace djetk {
+
+class TimerBase;
+
+/**
+ * \brief Group of timers whose expiries may be coalesced
+ *
+ * Timers that are started with a slack value may expire at any tick between
+ * their timeout and their timeout plus the slack. Timers that belong to the
+ * same group have their expiries aligned so that timers with overlapping
+ * windows expire on the same tick. When these timers post to the same queue,
+ * the consumer task wakes up once for the whole batch rather than once per
+ * timer.
+ *
+ * - Timers join the group on construction (see \ref TimerBase)
+ * - The group registers with the tick source during construction, so it is
+ *   notified of each tick before any of its timers. The group and its timers
+ *   must use the same tick source.
+ * - Expiries are aligned when a timer is started. A timer that can't share
+ *   a tick with any other timer expires at the end of its slack window so
+ *   that timers started later get the chance to join it.
+ */
+class TimerCoalescingGroup : private ITickClient {
+  public:
+    /**
+     * \brief Construct a timer coalescing group
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   error_handler   Callback to notify construction errors
+     */
+    TimerCoalescingGroup(ITickSource &tick_source, ICriticalErrorHandler &error_handler);
+
+    /**
+     * \brief Get the number of timer expiries within the group
+     */
+    uint32_t GetExpiryCount() const
+    {
+        return expiry_count_;
+    }
+
+    /**
+     * \brief Get the number of consumer wake-ups saved by coalescing
+     *
+     * This is the number of expiries that occurred on a tick where another
+     * timer of the group had already expired.
+     */
+    uint32_t GetWakeupsSaved() const
+    {
+        return wakeups_saved_;
+    }
+
+  private:
+    friend class TimerBase;
+
+    /**
+     * \brief Add a timer to the group
+     * \param[in]   timer   Timer to add
+     */
+    void AddTimer(TimerBase &timer);
+
+    /**
+     * \brief Remove a timer from the group
+     * \param[in]   timer   Timer to remove
+     */
+    void RemoveTimer(TimerBase &timer);
+
+    /**
+     * \brief Pick the expiry tick of a timer that is being started
+     * \param[in]   timer       Timer being started
+     * \param[in]   ticks       Earliest expiry in ticks from now
+     * \param[in]   slack_ticks Number of ticks the expiry may be delayed by
+     *
+     * Must be invoked with interrupts disabled.
+     */
+    void Schedule(TimerBase &timer, uint32_t ticks, uint32_t slack_ticks);
+
+    /**
+     * \brief Account for a timer expiry in the current tick
+     */
+    void NotifyExpiryFromIsr();
+
+    /**
+     * \brief See \ref ITickClient::OnTickFromIsr
+     */
+    virtual bool OnTickFromIsr(bool &task_woken) override;
+
+    TimerBase *timers_;
+    bool expired_this_tick_;
+    uint32_t expiry_count_;
+    uint32_t wakeups_saved_;
+};
+
+}    // namespace djetk
+
+#endif    // TIMER_COALESCING_GROUP_H
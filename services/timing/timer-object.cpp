@@ -28,64 +28,28 @@ namespace djetk {
 TimerObject::TimerObject(ITickSource &tick_source, IMessageQueue &message_queue,
             uint32_t message_id, ICriticalErrorHandler &error_handler,
             IOsServices &os_services)
-    : tick_source_(tick_source),
-    os_services_(os_services),
+    : TimerBase(tick_source, error_handler, os_services),
     message_queue_(message_queue),
-    message_id_(message_id),
-    reference_(0),
-    started_(false),
-    ticks_remaining_(0)
+    message_id_(message_id)
 {
-    if (!tick_source.RegisterTickClient(*this)) {
-        // Normally this function doesn't return, but during unit testing it
-        // does so break out after calling it.
-        error_handler.NotifyCriticalError(ICriticalErrorHandler::service_registration_error,
-                __FILE__, __LINE__);
-        return;
-    }
 }
 
-TimerObject::~TimerObject()
-{
-    // TODO Unregister from the tick source
-}
-
-void TimerObject::Start(uint32_t timeout_ms, int reference)
+TimerObject::TimerObject(ITickSource &tick_source, IMessageQueue &message_queue,
+            uint32_t message_id, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group)
+    : TimerBase(tick_source, error_handler, os_services, group),
+    message_queue_(message_queue),
+    message_id_(message_id)
 {
-    auto ticks = tick_source_.MsToTicks(timeout_ms);
-    if (!ticks) {
-        ticks++;
-    }
-
-    // Nested block has interrupts disabled
-    {
-        AutoInterruptDisabler disabler(os_services_);
-        reference_ = reference;
-        ticks_remaining_ = ticks;
-        started_ = true;
-    }
 }
 
-void TimerObject::Stop()
+TimerObject::~TimerObject()
 {
-    AutoInterruptDisabler disabler(os_services_);
-    started_ = false;
 }
 
-bool TimerObject::OnTickFromIsr(bool &task_woken)
+bool TimerObject::OnExpiryFromIsr(int reference, bool &task_woken)
 {
-    if (!started_) {
-        return true;
-    }
-
-    ticks_remaining_--;
-    if (ticks_remaining_) {
-        return true;
-    }
-
-    // Stop the timer
-    started_ = false;
-    TimeoutMessage message(message_id_, reference_);
+    TimeoutMessage message(message_id_, reference);
     return message_queue_.PostMessageFromIsr(message, task_woken);
 }
 
@@ -24,11 +24,8 @@
 #ifndef TIMER_OBJECT_H
 #define TIMER_OBJECT_H
 
-#include <timing/itick-client.h>
-#include <timing/itick-source.h>
+#include <timing/timer-base.h>
 #include <messaging/imessage-queue.h>
-#include <errors/icritical-error-handler.h>
-#include <os/ios-services.h>
 
 namespace djetk {
 
@@ -38,8 +35,11 @@ namespace djetk {
  *    messages (id injected) to an injected message queue
  *  - Expects ticks to originate from ISR context
  *  - Start/Stop operations disable interrupts temporarily
+ *
+ * The reference number given to \ref TimerBase::Start is included in the
+ * posted \ref TimeoutMessage.
  */
-class TimerObject : private ITickClient {
+class TimerObject : public TimerBase {
   public:
     /**
      * \brief Construct a timer object
@@ -56,45 +56,30 @@ class TimerObject : private ITickClient {
             uint32_t message_id, ICriticalErrorHandler &error_handler,
             IOsServices &os_services);
 
-    ~TimerObject();
-
     /**
-     * \brief (Re)Start the timer
-     * \param[in]   timeout_ms  Timeout period in milliseconds
-     * \param[in]   reference   Application specific reference id
-     *
-     * Start the timer if not already running. If the timer is running, it's
-     * re-started. The reference number is included in the timeout message that
-     * is posted to the queue that is injected during construction. This allows
-     * the client to avoid a race that can occur when a timeout event is in the
-     * queue when the Stop method is invoked.
-     *
-     * \note if the timeout_ms never converts to 0 ticks. At-least 1 system
-     * tick is guaranteed.
+     * \brief Construct a timer object that belongs to a coalescing group
+     * \param[in]   tick_source     Tick Source to register to
+     * \param[in]   message_queue   Queue to post timeout messages to
+     * \param[in]   message_id      ID of posted message
+     * \param[in]   error_handler   Callback to notify construction errors
+     * \param[in]   os_services     Interface to OS services
+     * \param[in]   group           Group to coalesce expiries with. It must
+     *              be registered to the same tick source.
      */
-    void Start(uint32_t timeout_ms, int reference);
+    TimerObject(ITickSource &tick_source, IMessageQueue &message_queue,
+            uint32_t message_id, ICriticalErrorHandler &error_handler,
+            IOsServices &os_services, TimerCoalescingGroup &group);
 
-    /**
-     * \brief Stop the timer if it's started
-     */
-    void Stop();
+    ~TimerObject();
 
   private:
-    ITickSource &tick_source_;
-    IOsServices &os_services_;
     IMessageQueue &message_queue_;
     uint32_t message_id_;
-    int reference_;
-    bool started_;
-    uint32_t ticks_remaining_;
 
-    // ITickClient interface implementation is private so that only the service
-    // that the interface is exposed only to the service that this object registers
-    // with.
     /**
-     * \brief See \ref ITickClient::OnTickFromIsr
+     * \brief See \ref TimerBase::OnExpiryFromIsr
      */
-    virtual bool OnTickFromIsr(bool &task_woken) override;
+    virtual bool OnExpiryFromIsr(int reference, bool &task_woken) override;
 };
 
 /**
@@ -0,0 +1,83 @@
+/**
+    \file
+    \brief Virtual time tick source implementation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <FreeRTOS/Source/include/FreeRTOS.h>
+#include <FreeRTOS/Source/include/task.h>
+#include <timing/virtual-tick-source.h>
+
+namespace djetk {
+
+VirtualTickSource::VirtualTickSource(TickClientsList &clients_buffer,
+        ICriticalErrorHandler &error_handler, uint32_t ms_per_tick)
+    : clients_(clients_buffer, error_handler),
+    ms_per_tick_(ms_per_tick ? ms_per_tick : 1),
+    tick_count_(0)
+{
+}
+
+bool VirtualTickSource::RegisterTickClient(ITickClient &client)
+{
+    return clients_.Register(client);
+}
+
+uint32_t VirtualTickSource::MsToTicks(uint32_t milliseconds)
+{
+    return milliseconds / ms_per_tick_;
+}
+
+uint32_t VirtualTickSource::KernelTicksToTicks(uint32_t kernel_ticks)
+{
+    uint64_t milliseconds = static_cast<uint64_t>(kernel_ticks) * portTICK_RATE_MS;
+    return static_cast<uint32_t>(milliseconds / ms_per_tick_);
+}
+
+bool VirtualTickSource::Step(uint32_t ticks)
+{
+    bool task_woken = false;
+    for (uint32_t i = 0; i < ticks; i++) {
+        bool tick_task_woken = false;
+        clients_.NotifyTickFromIsr(tick_task_woken);
+        tick_count_++;
+        task_woken = task_woken || tick_task_woken;
+    }
+
+    return task_woken;
+}
+
+void VirtualTickSource::OnIdle()
+{
+    bool task_woken;
+
+    // Tick clients expect to be invoked from the tick ISR. Being in a critical
+    // section keeps tasks from preempting the idle task mid-tick.
+    taskENTER_CRITICAL();
+    task_woken = Step();
+    taskEXIT_CRITICAL();
+
+    // Let the woken tasks run before time moves on
+    if (task_woken) {
+        taskYIELD();
+    }
+}
+
+}    // namespace djetk
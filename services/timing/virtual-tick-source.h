@@ -0,0 +1,113 @@
+/**
+    \file
+    \brief Virtual time tick source for simulation
+
+    \copyright
+    Copyright (C) 2015 Dushara Jayasinghe
+
+    This file is part of DJETK
+
+    DJETK is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    DJETK is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with DJETK.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VIRTUAL_TICK_SOURCE_H
+#define VIRTUAL_TICK_SOURCE_H
+
+#include <timing/itick-source.h>
+#include <timing/itick-counter.h>
+#include <timing/tick-client-registry.h>
+#include <os/iidle-handler.h>
+#include <errors/icritical-error-handler.h>
+
+namespace djetk {
+
+/**
+ * \brief Tick source driven by a virtual clock
+ *
+ * Time only advances when the clock is stepped, either explicitly through
+ * \ref Step or from the scheduler idle hook (see
+ * FreeRTOSScheduler::RegisterIdleHandler). Driven from the idle hook, one tick
+ * elapses each time all the tasks are blocked, so long timer scenarios run
+ * as fast as the CPU allows and produce the same sequence of events on every
+ * run.
+ *
+ * - Only time measured through this tick source is virtual. Kernel delays and
+ *   queue timeouts still run off the FreeRTOS tick, in real time. Tasks
+ *   under virtual time should wait on timers registered here and block on
+ *   their queues without a timeout.
+ * - Ticks are notified in a critical section to mimic the tick ISR
+ */
+class VirtualTickSource : public ITickSource,
+                          public ITickCounter,
+                          public IIdleHandler {
+  public:
+    /**
+     * \brief Construct the tick source using the injected clients buffer
+     * \param[in]   clients_buffer  Buffer to store pointers to the registered clients
+     * \param[in]   error_handler   Callback reference to notify of errors
+     * \param[in]   ms_per_tick     Virtual tick period in milliseconds
+     */
+    VirtualTickSource(TickClientsList &clients_buffer,
+            ICriticalErrorHandler &error_handler, uint32_t ms_per_tick = 1);
+
+    /**
+     * \brief See \ref ITickSource::RegisterTickClient
+     */
+    virtual bool RegisterTickClient(ITickClient &client) override;
+
+    /**
+     * \brief See \ref ITickSource::MsToTicks
+     */
+    virtual uint32_t MsToTicks(uint32_t milliseconds) override;
+
+    /**
+     * \brief See \ref ITickSource::KernelTicksToTicks
+     */
+    virtual uint32_t KernelTicksToTicks(uint32_t kernel_ticks) override;
+
+    /**
+     * \brief Advance the virtual clock
+     * \param[in]   ticks   Number of ticks to advance by
+     * \return true if a task was woken by any of the clients
+     *
+     * Registered clients are notified once per tick.
+     */
+    bool Step(uint32_t ticks = 1);
+
+    /**
+     * \brief Get the number of ticks elapsed since construction
+     *
+     * See \ref ITickCounter::GetTickCount
+     */
+    virtual uint32_t GetTickCount() const override
+    {
+        return tick_count_;
+    }
+
+    /**
+     * \brief Advance the clock by a tick while all tasks are blocked
+     *
+     * See \ref IIdleHandler::OnIdle
+     */
+    virtual void OnIdle() override;
+
+  private:
+    TickClientRegistry clients_;
+    uint32_t ms_per_tick_;
+    uint32_t tick_count_;
+};
+
+}    // namespace djetk
+
+#endif    // VIRTUAL_TICK_SOURCE_H
@@ -0,0 +1,230 @@
+#!/usr/bin/env python
+"""Response time analysis of measured ISRs and tasks.
+
+The input is the text written by djetk::ProfileReport, one entry per line:
+
+    kind,name,priority,wcet_cycles,rate_hz,blocking_cycles
+
+Each entry is treated as a periodic activity with a period of 1 / rate_hz and
+a deadline equal to its period. ISRs preempt all tasks, and among each other
+run in the order of their priority. Tasks are scheduled by fixed priority
+preemption, where tasks of equal priority are assumed to delay each other.
+
+blocking_cycles is the longest time the entry blocks others (e.g. while
+holding a mutex). It is charged to the higher priority entries of the same
+kind: each entry is blocked for the longest blocking time of the entries
+below it. As blocking depends on the entries assigned below, the recommended
+assignment is no longer guaranteed to be optimal when there is blocking.
+
+The script reports the worst case response time of every entry under the
+current priorities and under a recommended task priority assignment
+(Audsley's optimal priority assignment). It also reports the CPU utilisation
+and how much longer every execution time may grow, as a percentage, before
+any deadline is missed.
+
+Usage: response-time-analysis.py <cpu-hz> <report-file>
+"""
+
+import sys
+
+# Scale factors are searched up to this value when computing the headroom
+MAX_SCALE = 1000.0
+
+
+class Entry(object):
+    def __init__(self, kind, name, priority, wcet, period, blocking):
+        self.kind = kind
+        self.name = name
+        self.priority = priority
+        self.wcet = wcet
+        self.period = period
+        self.blocking = blocking
+        self.recommended = None
+
+
+def parse(lines, cpu_hz):
+    entries = []
+    for number, line in enumerate(lines, 1):
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+
+        fields = line.split(',')
+        if len(fields) != 6 or fields[0] not in ('isr', 'task'):
+            sys.stderr.write('line %d: ignoring "%s"\n' % (number, line))
+            continue
+
+        kind, name = fields[0], fields[1]
+        priority, wcet, rate, blocking = [int(field) for field in fields[2:]]
+        if rate == 0:
+            sys.stderr.write('line %d: %s has no measured arrivals, ignored\n' %
+                             (number, name))
+            continue
+
+        entries.append(Entry(kind, name, priority, wcet, float(cpu_hz) / rate,
+                             blocking))
+
+    return entries
+
+
+def blocking_time(lower):
+    """Longest time the lower priority entries may block an entry."""
+    return max([e.blocking for e in lower] + [0])
+
+
+def response_time(entry, higher, lower, scale=1.0):
+    """Return the worst case response time of entry, or None if it misses
+    its deadline while being preempted by the higher priority entries and
+    blocked by the lower priority ones."""
+    wcet = entry.wcet * scale
+    blocking = blocking_time(lower) * scale
+    response = wcet + blocking
+    while True:
+        interference = 0.0
+        for other in higher:
+            activations = -(-response // other.period)
+            interference += activations * other.wcet * scale
+
+        updated = wcet + blocking + interference
+        if updated > entry.period:
+            return None
+        if updated == response:
+            return response
+        response = updated
+
+
+def current_higher(entry, entries):
+    """Entries that may delay entry under the current priorities."""
+    isrs = [e for e in entries if e.kind == 'isr']
+    if entry.kind == 'isr':
+        return [e for e in isrs if e is not entry and e.priority >= entry.priority]
+
+    return isrs + [e for e in entries if e.kind == 'task' and e is not entry and
+                   e.priority >= entry.priority]
+
+
+def current_lower(entry, entries):
+    """Entries of the same kind that may block entry under the current
+    priorities."""
+    return [e for e in entries if e.kind == entry.kind and e.priority < entry.priority]
+
+
+def recommend(entries, scale=1.0):
+    """Audsley's algorithm over the tasks. Returns the tasks ordered from the
+    lowest to the highest priority, or None if no assignment meets all the
+    deadlines."""
+    isrs = [e for e in entries if e.kind == 'isr']
+    unassigned = [e for e in entries if e.kind == 'task']
+    order = []
+    while unassigned:
+        # Prefer the longest deadline among the tasks that fit the lowest
+        # free priority, which keeps the result close to deadline monotonic
+        candidates = sorted(unassigned, key=lambda e: e.period, reverse=True)
+        for task in candidates:
+            higher = isrs + [e for e in unassigned if e is not task]
+            if response_time(task, higher, order, scale) is not None:
+                break
+        else:
+            return None
+
+        unassigned.remove(task)
+        order.append(task)
+
+    return order
+
+
+def schedulable(entries, scale):
+    isrs = [e for e in entries if e.kind == 'isr']
+    for isr in isrs:
+        if response_time(isr, current_higher(isr, entries), current_lower(isr, entries),
+                         scale) is None:
+            return False
+
+    return recommend(entries, scale) is not None
+
+
+def headroom(entries):
+    """Largest factor all execution times may be scaled by while meeting
+    every deadline."""
+    low, high = 0.0, MAX_SCALE
+    if not schedulable(entries, low):
+        return None
+
+    for _ in range(60):
+        middle = (low + high) / 2
+        if schedulable(entries, middle):
+            low = middle
+        else:
+            high = middle
+
+    return low
+
+
+def format_time(value, cpu_hz):
+    if value is None:
+        return 'MISS'
+
+    return '%.1f' % (value * 1e6 / cpu_hz)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write(__doc__)
+        return 1
+
+    cpu_hz = float(argv[1])
+    with open(argv[2]) as report_file:
+        entries = parse(report_file, cpu_hz)
+
+    if not entries:
+        sys.stderr.write('no entries to analyse\n')
+        return 1
+
+    order = recommend(entries)
+    if order is not None:
+        for level, task in enumerate(order, 1):
+            task.recommended = level
+        recommended_higher = dict(
+            (task, [e for e in entries if e.kind == 'isr'] + order[level:])
+            for level, task in enumerate(order, 1))
+        recommended_lower = dict(
+            (task, order[:level - 1]) for level, task in enumerate(order, 1))
+
+    print('%-4s %-20s %5s %10s %10s %10s %5s %10s' %
+          ('Kind', 'Name', 'Prio', 'WCET us', 'Period us', 'Resp us', 'Rec', 'Rec us'))
+    all_met = True
+    for entry in sorted(entries, key=lambda e: (e.kind != 'isr', -e.priority)):
+        current = response_time(entry, current_higher(entry, entries),
+                                current_lower(entry, entries))
+        all_met = all_met and current is not None
+        if entry.kind == 'isr':
+            recommended, recommended_response = entry.priority, current
+        elif order is None:
+            recommended, recommended_response = '-', None
+        else:
+            recommended = entry.recommended
+            recommended_response = response_time(entry, recommended_higher[entry],
+                                                 recommended_lower[entry])
+
+        print('%-4s %-20s %5d %10s %10s %10s %5s %10s' %
+              (entry.kind, entry.name, entry.priority,
+               format_time(entry.wcet, cpu_hz), format_time(entry.period, cpu_hz),
+               format_time(current, cpu_hz), recommended,
+               format_time(recommended_response, cpu_hz)))
+
+    utilisation = sum(e.wcet / e.period for e in entries)
+    print('')
+    print('Utilisation: %.1f%%' % (utilisation * 100))
+    print('Current priorities meet all deadlines: %s' % ('yes' if all_met else 'no'))
+    if order is None:
+        print('No task priority assignment meets all deadlines')
+        return 2
+
+    scale = headroom(entries)
+    print('Recommended task priorities are tskIDLE_PRIORITY + Rec')
+    print('Headroom: execution times may grow by %.1f%%' % ((scale - 1) * 100))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+"""Report the RAM reserved by statically allocated tasks.
+
+Tasks defined with the DJETK_STATIC_TASK(name) macro are placed in input
+sections named .bss.djetk_task.<name>. This script lists those sections from
+a GNU ld map file (-Wl,-Map=<file>) along with their sizes. The size covers
+the whole task object, of which the embedded stack is the bulk.
+
+Usage: task-stack-report.py <map-file>
+"""
+
+import re
+import sys
+
+SECTION_PREFIX = '.bss.djetk_task.'
+
+# An input section line is either complete:
+#   .bss.djetk_task.name  0x20000100  0x1a8 main.o
+# or split when the section name is too long:
+#   .bss.djetk_task.name
+#                 0x20000100  0x1a8 main.o
+ADDRESS_SIZE = re.compile(r'\s*(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S+)')
+
+
+def parse(lines):
+    tasks = []
+    pending = None
+    for line in lines:
+        stripped = line.strip()
+        if pending is not None:
+            match = ADDRESS_SIZE.match(line)
+            if match:
+                tasks.append((pending,) + match.groups())
+            pending = None
+            continue
+
+        if not stripped.startswith(SECTION_PREFIX):
+            continue
+
+        fields = stripped.split(None, 1)
+        name = fields[0][len(SECTION_PREFIX):]
+        if len(fields) == 1:
+            pending = name
+            continue
+
+        match = ADDRESS_SIZE.match(fields[1])
+        if match:
+            tasks.append((name,) + match.groups())
+
+    return tasks
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    with open(argv[1]) as map_file:
+        tasks = parse(map_file)
+
+    total = 0
+    print('%-24s %-12s %8s  %s' % ('Task', 'Address', 'Bytes', 'Object'))
+    for name, address, size, obj in tasks:
+        size = int(size, 16)
+        total += size
+        print('%-24s %-12s %8d  %s' % (name, address, size, obj))
+
+    print('%-24s %-12s %8d' % ('Total', '', total))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+"""Tests of response-time-analysis.py.
+
+Usage: test-response-time-analysis.py
+"""
+
+import os
+import sys
+import tempfile
+import unittest
+
+SCRIPT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      'response-time-analysis.py')
+
+try:
+    import importlib.util
+    spec = importlib.util.spec_from_file_location('rta', SCRIPT)
+    rta = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(rta)
+except ImportError:
+    import imp
+    rta = imp.load_source('rta', SCRIPT)
+
+# With a 1 kHz CPU, cycles are milliseconds
+CPU_HZ = 1000
+
+
+def parse(text):
+    return rta.parse(text.splitlines(), CPU_HZ)
+
+
+def find(entries, name):
+    return [e for e in entries if e.name == name][0]
+
+
+class ResponseTimeTest(unittest.TestCase):
+
+    def test_parse_valid_and_invalid_lines(self):
+        entries = parse('# comment\n'
+                        'task,a,1,10,10,5\n'
+                        'task,idle,0,10,0,0\n'
+                        'bogus,b,1,10,10,0\n')
+        self.assertEqual(['a'], [e.name for e in entries])
+        self.assertEqual(100, entries[0].period)
+        self.assertEqual(5, entries[0].blocking)
+
+    def test_blocking_charged_to_higher_priority_entries(self):
+        entries = parse('task,high,2,10,10,0\n'
+                        'task,low,1,20,5,30\n')
+        high, low = find(entries, 'high'), find(entries, 'low')
+
+        # The mutex held by low delays high, not low itself
+        self.assertEqual(40, rta.response_time(high, rta.current_higher(high, entries),
+                                               rta.current_lower(high, entries)))
+        self.assertEqual(30, rta.response_time(low, rta.current_higher(low, entries),
+                                               rta.current_lower(low, entries)))
+
+    def test_task_blocking_not_charged_to_isrs(self):
+        entries = parse('isr,uart,1,5,10,0\n'
+                        'task,low,1,20,5,30\n')
+        uart = find(entries, 'uart')
+        self.assertEqual(5, rta.response_time(uart, rta.current_higher(uart, entries),
+                                              rta.current_lower(uart, entries)))
+
+    def test_recommend_blocking_follows_assignment(self):
+        # Currently b blocks nothing as it has the highest priority
+        entries = parse('task,a,1,10,10,0\n'
+                        'task,b,2,20,5,30\n')
+        a, b = find(entries, 'a'), find(entries, 'b')
+        self.assertEqual(20, rta.response_time(b, rta.current_higher(b, entries),
+                                               rta.current_lower(b, entries)))
+
+        # Once a is placed above b, a is blocked by b
+        self.assertEqual([b, a], rta.recommend(entries))
+        self.assertEqual(40, rta.response_time(a, [], [b]))
+        self.assertEqual(30, rta.response_time(b, [a], []))
+
+    def test_main_report_exit_status(self):
+        report = tempfile.NamedTemporaryFile('w', suffix='.txt', delete=False)
+        try:
+            report.write('isr,uart,1,5,10,0\n'
+                         'task,high,2,10,10,0\n'
+                         'task,low,1,20,5,30\n')
+            report.close()
+            stdout = sys.stdout
+            sys.stdout = open(os.devnull, 'w')
+            try:
+                status = rta.main(['rta', str(CPU_HZ), report.name])
+            finally:
+                sys.stdout.close()
+                sys.stdout = stdout
+        finally:
+            os.remove(report.name)
+
+        self.assertEqual(0, status)
+
+
+if __name__ == '__main__':
+    unittest.main()